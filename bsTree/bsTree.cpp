@@ -13,6 +13,16 @@
  * - Search: Checks if a value exists within the tree.
  * - Get Height: Calculates the height of the tree.
  * - Visual Print: Displays the tree structure in a simple console format.
+ * - Balanced mode: AVL insertion and removal (`insertBalanced`, `removeBalanced`) that rotate
+ *   the tree so its height stays O(log n), even when keys arrive in sorted order.
+ *
+ * Insert, search and remove are iterative, so deep (unbalanced) trees can't overflow the stack.
+ * Every node caches the height and size of its subtree, refreshed along the changed path, which
+ * makes `getHeight` O(1).
+ *
+ * Order statistics: the cached sizes answer `rank` (keys below a value), `select` (k-th smallest
+ * key) and `countRange` (keys in [low, high]) in O(height), and `RangeIterator` visits in order
+ * only the keys of a range.
  *
  * Usage:
  * The `interface()` function handles user input for interacting with the tree. Users 
@@ -28,30 +38,193 @@
 #include <queue>
 #include <iomanip>  
 #include <cmath>
+#include <algorithm>
+#include <vector>
 struct Node {
     int value;
+    int height;  // Levels of the subtree rooted here
+    int size;    // Nodes of the subtree rooted here
     struct Node *left;
     struct Node *right;
 };
 
 typedef Node* Tree;
 
+/**
+ * Height cached in a node.
+ * @param tree The subtree (may be empty).
+ * @return The cached height, 0 for an empty subtree.
+ */
+int nodeHeight(Tree tree){
+    return tree ? tree->height : 0;
+}
+
+/**
+ * Size cached in a node.
+ * @param tree The subtree (may be empty).
+ * @return The number of nodes in the subtree, 0 for an empty subtree.
+ */
+int nodeSize(Tree tree){
+    return tree ? tree->size : 0;
+}
+
+/**
+ * Recomputes the cached height and size of a node from its children.
+ * @param tree The node to update.
+ */
+void updateNode(Tree tree){
+    tree->height = 1 + std::max(nodeHeight(tree->left), nodeHeight(tree->right));
+    tree->size = 1 + nodeSize(tree->left) + nodeSize(tree->right);
+}
+
+/**
+ * Rotates the subtree to the left: the right child becomes its root.
+ * @param tree Reference to the subtree root, replaced by the new root.
+ */
+void rotateLeft(Tree& tree){
+    Tree child = tree->right;
+    tree->right = child->left;
+    child->left = tree;
+    updateNode(tree);
+    updateNode(child);
+    tree = child;
+}
+
+/**
+ * Rotates the subtree to the right: the left child becomes its root.
+ * @param tree Reference to the subtree root, replaced by the new root.
+ */
+void rotateRight(Tree& tree){
+    Tree child = tree->left;
+    tree->left = child->right;
+    child->right = tree;
+    updateNode(tree);
+    updateNode(child);
+    tree = child;
+}
+
+/**
+ * Restores the AVL property at a node whose children differ in height by at most 2.
+ * @param tree Reference to the subtree root, replaced if a rotation happens.
+ */
+void rebalance(Tree& tree){
+    updateNode(tree);
+    int balance = nodeHeight(tree->left) - nodeHeight(tree->right);
+    if(balance > 1){
+        if(nodeHeight(tree->left->left) < nodeHeight(tree->left->right))
+            rotateLeft(tree->left);  // Left-right case
+        rotateRight(tree);
+    } else if(balance < -1){
+        if(nodeHeight(tree->right->right) < nodeHeight(tree->right->left))
+            rotateRight(tree->right);  // Right-left case
+        rotateLeft(tree);
+    }
+}
+
+const int PATH_INLINE_LINKS = 64;  // AVL height stays below 1.45 * log2(n + 2), so any AVL path fits
+
+/**
+ * Links from the root down to the node being changed. They are kept in a fixed array, which is
+ * always enough for an AVL tree; a deeper (unbalanced) path spills into a per-thread buffer that
+ * keeps its capacity between calls, so inserts and removes don't allocate once it has grown.
+ */
+class TreePath{
+    private:
+        Tree* inline_links[PATH_INLINE_LINKS];
+        Tree** links;    // inline_links, or the spill buffer after the path outgrew it
+        int capacity;
+        int depth;
+    public:
+        TreePath();
+        void push(Tree*);
+        int size();
+        Tree* operator[](int);
+};
+
+TreePath::TreePath(){
+    links = inline_links;
+    capacity = PATH_INLINE_LINKS;
+    depth = 0;
+}
+
+/**
+ * Appends a link, moving the path to the spill buffer when the fixed array is full.
+ */
+void TreePath::push(Tree* link){
+    if(depth == capacity){
+        static thread_local std::vector<Tree*> spill;  // Only one path per thread is alive at a time
+        spill.resize(std::max(spill.size(), (std::size_t)capacity * 2));
+        if(links == inline_links)
+            std::copy(inline_links, inline_links + depth, spill.data());
+        links = spill.data();
+        capacity = (int)spill.size();
+    }
+    links[depth++] = link;
+}
+
+int TreePath::size(){
+    return depth;
+}
+
+Tree* TreePath::operator[](int i){
+    return links[i];
+}
+
+/**
+ * Walks back up a path of links, refreshing the cached height and size of every node on it
+ * (and rebalancing it if the tree is an AVL tree).
+ * @param path Links from the root down to the lowest changed node.
+ * @param balanced Whether to rebalance.
+ */
+void fixPath(TreePath& path, bool balanced){
+    for(int i = path.size(); i-- > 0;){
+        if(*path[i] == nullptr)
+            continue;
+        if(balanced)
+            rebalance(*path[i]);
+        else
+            updateNode(*path[i]);
+    }
+}
+
+/**
+ * Inserts a value without recursion, keeping every cached height and size up to date.
+ * @param tree Reference to the tree where the value is to be inserted.
+ * @param value The integer value to insert.
+ * @param balanced Whether to rebalance on the way back up (AVL).
+ */
+void insertNode(Tree& tree, int value, bool balanced){
+    TreePath path;
+    Tree* link = &tree;
+    while(*link != nullptr){
+        path.push(link);
+        link = value < (*link)->value ? &(*link)->left : &(*link)->right;
+    }
+    *link = new Node;
+    (*link)->left = nullptr;
+    (*link)->right = nullptr;
+    (*link)->value = value;
+    (*link)->height = 1;
+    (*link)->size = 1;
+    fixPath(path, balanced);
+}
+
 /**
  * Inserts a value into the binary search tree.
  * @param tree Reference to the tree where the value is to be inserted.
  * @param value The integer value to insert.
  */
 void insert(Tree& tree, int value){
-    if(tree == nullptr){
-        tree = new Node;
-        tree->left = nullptr;
-        tree->right = nullptr;
-        tree->value = value;
-    } else if (value < tree->value) {
-        insert(tree->left, value);
-    } else {
-        insert(tree->right, value);
-    }
+    insertNode(tree, value, false);
+}
+
+/**
+ * Inserts a value into an AVL tree, rotating on the way back up so the height stays O(log n).
+ * @param tree Reference to the tree where the value is to be inserted.
+ * @param value The integer value to insert.
+ */
+void insertBalanced(Tree& tree, int value){
+    insertNode(tree, value, true);
 }
 
 /**
@@ -61,77 +234,187 @@ void insert(Tree& tree, int value){
  * @return True if the value is found, otherwise false.
  */
 bool search(Tree tree, int value){
-    if(tree){
+    while(tree){
         if(tree->value == value)
             return true;
-        if(value < tree->value)
-            return search(tree->left,value);
-        if(value > tree->value)
-            return search(tree->right,value);
+        tree = value < tree->value ? tree->left : tree->right;
     }
     return false;
 }
 
 /**
- * Removes a value from the binary search tree.
+ * Removes a value without recursion, keeping every cached height and size up to date.
  * @param tree Reference to the tree from which to remove the value.
  * @param value The integer value to remove.
- * @note Prints a message indicating whether the value was found and removed.
+ * @param balanced Whether to rebalance on the way back up (AVL).
+ * @param printOpt 0 prints whether the value was found and removed.
+ * @return True if the value was found.
  */
-void remove(Tree& tree, int value, int printOpt = 0) {
+bool removeNode(Tree& tree, int value, bool balanced, int printOpt){
+    TreePath path;
+    Tree* link = &tree;
+    while(*link != nullptr && (*link)->value != value){
+        path.push(link);
+        link = value < (*link)->value ? &(*link)->left : &(*link)->right;
+    }
     // Value not found
-    if (tree == nullptr){
+    if(*link == nullptr){
         std::cout << "-----------Value " << value << " not found-----------\n";
-        return;
+        return false;
     }
-    // Value is lower than tree value
-    else if (value < tree->value) 
-        remove(tree->left, value, printOpt);
-    // Value is higher  than tree value
-    else if (value > tree->value) 
-        remove(tree->right, value, printOpt); 
-    // Value found
-    else {
-        if(printOpt == 0)
-            std::cout << "-----------Value " << value << " found and removed-----------\n";
-        // Node doesn't have children
-        if (tree->left == nullptr && tree->right == nullptr) {
-            delete tree;
-            tree = nullptr;
-        // Node doesn't have left child
-        } else if (tree->left == nullptr) {
-            tree = tree->right;
-        // Node doesn't have right child
-        } else if (tree->right == nullptr) {
-            tree = tree->left;
-        // Node has both children
-        } else {
-            // Find lower element in right subtree
-            Tree temp = tree->right;
-            while (temp->left != nullptr) {
-                temp = temp->left;
-            }
-            tree->value = temp->value; // Change tree value for lower value in right subtree
-            remove(tree->right, temp->value, 1); // Remove lower element in right subtree and doesn't print
+    if(printOpt == 0)
+        std::cout << "-----------Value " << value << " found and removed-----------\n";
+    Tree node = *link;
+    // Node has both children: take the lower element in right subtree and remove that node instead
+    if(node->left != nullptr && node->right != nullptr){
+        path.push(link);
+        link = &node->right;
+        while((*link)->left != nullptr){
+            path.push(link);
+            link = &(*link)->left;
         }
+        node->value = (*link)->value;
+        node = *link;
     }
+    *link = node->left ? node->left : node->right;
+    delete node;
+    fixPath(path, balanced);
+    return true;
+}
+
+/**
+ * Removes a value from the binary search tree.
+ * @param tree Reference to the tree from which to remove the value.
+ * @param value The integer value to remove.
+ * @note Prints a message indicating whether the value was found and removed.
+ */
+void remove(Tree& tree, int value, int printOpt = 0) {
+    removeNode(tree, value, false, printOpt);
+}
+
+/**
+ * Removes a value from an AVL tree, rotating on the way back up so the height stays O(log n).
+ * @param tree Reference to the tree from which to remove the value.
+ * @param value The integer value to remove.
+ * @note Prints a message indicating whether the value was found and removed.
+ */
+void removeBalanced(Tree& tree, int value, int printOpt = 0){
+    removeNode(tree, value, true, printOpt);
 }
 
 /**
- * Calculates the height of the binary search tree.
- * @param tree The tree for which to calculate the height.
+ * Height of the binary search tree, read from the cache kept by every update.
+ * @param tree The tree for which to get the height.
  * @return The height of the tree as an integer.
  */
 int getHeight(Tree tree) {
-    if (tree == nullptr) {
+    return nodeHeight(tree);
+}
+
+/**
+ * Counts the keys lower than a value (or lower or equal, if inclusive).
+ * @param tree The tree to search within.
+ * @param value The value to rank.
+ * @param inclusive Whether keys equal to value count too.
+ * @return The number of keys below value, which is also the position value would take in order.
+ */
+int rank(Tree tree, int value, bool inclusive = false){
+    int count = 0;
+    while(tree){
+        if(tree->value < value || (inclusive && tree->value == value)){
+            count += nodeSize(tree->left) + 1;
+            tree = tree->right;
+        } else
+            tree = tree->left;
+    }
+    return count;
+}
+
+/**
+ * Finds the k-th smallest key (k = 0 is the minimum).
+ * @param tree The tree to search within.
+ * @param k The position of the key in order.
+ * @param value Receives the key when it exists.
+ * @return True if the tree has more than k keys, otherwise false.
+ */
+bool select(Tree tree, int k, int& value){
+    if(k < 0 || k >= nodeSize(tree))
+        return false;
+    while(true){
+        int leftSize = nodeSize(tree->left);
+        if(k < leftSize)
+            tree = tree->left;
+        else if(k == leftSize){
+            value = tree->value;
+            return true;
+        } else{
+            k -= leftSize + 1;
+            tree = tree->right;
+        }
+    }
+}
+
+/**
+ * Counts the keys in the closed range [low, high].
+ * @param tree The tree to search within.
+ * @param low The lower bound of the range.
+ * @param high The upper bound of the range.
+ * @return The number of keys between low and high.
+ */
+int countRange(Tree tree, int low, int high){
+    if(low > high)
         return 0;
-    } else {
-        int heightLeft = getHeight(tree->left);
-        int heightRight = getHeight(tree->right);
-        return 1 + std::max(heightLeft, heightRight);
+    return rank(tree, high, true) - rank(tree, low);
+}
+
+/**
+ * In-order iterator over the keys of a closed range [low, high]. It only keeps the path to the
+ * next key, so it visits the keys of the range plus O(height) nodes on the way down.
+ */
+class RangeIterator{
+    private:
+        std::vector<Tree> path;  // Nodes whose key and right subtree are still to be visited
+        int high;
+        void descend(Tree, int);
+    public:
+        RangeIterator(Tree, int, int);
+        bool hasNext();
+        int next();
+};
+
+/**
+ * Pushes the nodes with key >= low along the way to the lowest such key of a subtree.
+ */
+void RangeIterator::descend(Tree tree, int low){
+    while(tree){
+        if(tree->value < low)
+            tree = tree->right;  // Whole left subtree is below the range
+        else{
+            path.push_back(tree);
+            tree = tree->left;
+        }
     }
 }
 
+RangeIterator::RangeIterator(Tree tree, int low, int high){
+    this->high = high;
+    descend(tree, low);
+}
+
+bool RangeIterator::hasNext(){
+    return !path.empty() && path.back()->value <= high;
+}
+
+/**
+ * Returns the next key of the range (hasNext() must be true).
+ */
+int RangeIterator::next(){
+    Tree tree = path.back();
+    path.pop_back();
+    descend(tree->right, tree->value);  // Everything to the right is >= this key
+    return tree->value;
+}
+
 /**
  * Populates a matrix used for printing the tree visually.
  * @param M The matrix to populate.
@@ -226,11 +509,17 @@ void TreePrinter(Tree tree) {
 void interface(){
     Tree tree = nullptr;
     char option = 'y';
-    int operation, value;
+    char balanced;
+    int operation, value, low, high;
+    std::cout << "Should the tree stay balanced (AVL)? (y/n)\n";
+    std::cin >> balanced;
+    bool isBalanced = balanced == 'y' || balanced == 'Y';
+    system("cls");
     while(option == 'y' || option == 'Y'){
         std::cout << "What operation?"
         << "\n1 - Insert\n2 - Remove\n3 - Search"
-        << "\n4 - Get Height\n";
+        << "\n4 - Get Height\n5 - Rank\n6 - Select k-th smallest"
+        << "\n7 - Count values in range\n8 - Print values in range\n";
         std::cin >> operation;
         system("cls");
         switch (operation)
@@ -238,13 +527,19 @@ void interface(){
             case 1:
                 std::cout << "What integer do you want to insert? ";
                 std::cin >> value;
-                insert(tree, value);
+                if(isBalanced)
+                    insertBalanced(tree, value);
+                else
+                    insert(tree, value);
                 TreePrinter(tree);
                 break;
             case 2:
                 std::cout << "What value do you want to remove? ";
                 std::cin >> value;
-                remove(tree, value);
+                if(isBalanced)
+                    removeBalanced(tree, value);
+                else
+                    remove(tree, value);
                 TreePrinter(tree);
                 break;
             case 3:
@@ -260,6 +555,33 @@ void interface(){
                 TreePrinter(tree);
                 std::cout << "-----------Height is = " << getHeight(tree) << "-----------\n\n";
                 break;
+            case 5:
+                std::cout << "What value do you want to rank? ";
+                std::cin >> value;
+                std::cout << "-----------" << rank(tree, value) << " values are lower than " << value << "-----------\n\n";
+                break;
+            case 6:
+                std::cout << "Which position (0 is the lowest)? ";
+                std::cin >> low;
+                if(select(tree, low, value))
+                    std::cout << "-----------Value at position " << low << " is " << value << "-----------\n\n";
+                else
+                    std::cout << "-----------Tree doesn't have " << low + 1 << " values-----------\n\n";
+                break;
+            case 7:
+                std::cout << "Lower and upper bounds of the range? ";
+                std::cin >> low >> high;
+                std::cout << "-----------" << countRange(tree, low, high) << " values in the range-----------\n\n";
+                break;
+            case 8: {
+                std::cout << "Lower and upper bounds of the range? ";
+                std::cin >> low >> high;
+                RangeIterator iterator(tree, low, high);
+                while(iterator.hasNext())
+                    std::cout << iterator.next() << " ";
+                std::cout << "\n\n";
+                break;
+            }
             default:
                 std::cout << "Invalid Case. Try another one\n";
         }
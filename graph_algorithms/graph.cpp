@@ -28,21 +28,100 @@ Data Structures and Algorithms - Topological sorting
  * The output of the program displays the order in which to put on the clothes, ensuring that prerequisites are met.
  *
  * Classes:
- * - Graph: Represents a graph using an adjacency list and provides methods for adding edges, 
- *   performing DFS, and finding the topological sorting.
+ * - IncrementalTopologicalOrder: Keeps a valid topological order of a Graph while edges are inserted
+ *   (Pearce-Kelly). Only the region between the two endpoints of a new edge is reordered, and edges that
+ *   would close a cycle are rejected.
+ * - DagExecutor: Runs a callable attached to each vertex on a work-stealing thread pool, starting a vertex as
+ *   soon as all its predecessors are done, and reports the critical path and the achieved parallelism.
+ * - ReachabilityIndex: Answers "is v reachable from u" (u transitively requires v) without a fresh DFS per query.
+ * - NameTable: Concurrent hash table (sharded, one lock per shard) that interns vertex names into dense ids.
+ * - MappedFile: Read-only memory mapping of a whole file (mmap on POSIX, MapViewOfFile on Windows).
+ * - Barrier: Reusable thread barrier used to separate the levels of the parallel topological sort.
+ * - Graph: Represents a graph sized at runtime. Edges are collected by addEdge and then frozen into a
+ *   compressed-sparse-row (CSR) layout: one offsets array plus one contiguous targets array, so traversals
+ *   walk contiguous memory instead of one heap vector per vertex.
  *
  * Methods:
- * - Graph::Graph(): Initializes the graph, marking all vertices as not visited.
+ * - Graph::Graph(int vertices): Initializes an empty graph with the given number of vertices.
  * - void Graph::addEdge(int u, int v): Adds a directed edge from vertex u to vertex v.
+ * - Graph::Graph(const std::string& path): Maps a binary graph file and uses its arrays directly as the
+ *   adjacency storage, with no parsing. Only O(1) checks run here (header, array sizes against the file
+ *   length, first and last offsets), so opening stays fast; throws std::runtime_error if they fail.
+ * - void Graph::validate() const: O(V + E) scan that offsets never decrease, that every target is a vertex
+ *   and that name offsets stay inside the arena; throws std::runtime_error otherwise. Call it once before
+ *   traversing a file that may be corrupted.
+ * - void Graph::compress(): Switches to compressed adjacency: each neighbor list is sorted and stored as
+ *   variable-length gaps (the first one zigzag-encoded relative to the source vertex) in one byte stream.
+ *   Every traversal decodes the lists on the fly. Sorting changes the order in which DFS visits neighbors.
+ *   Edges added later are merged on the next freeze, which compresses again.
+ * - void Graph::freeze(): Builds the CSR arrays from the edges added so far. Called automatically before
+ *   any traversal; edges added afterwards are merged on the next freeze (into memory owned by the graph).
+ * - void Graph::saveBinary(const std::string& path): Writes the graph in the binary format described below.
+ * - static void Graph::convertEdgeList(const std::string& text_path, const std::string& binary_path):
+ *   Converts a text edge list ("u v" per line, '#' starts a comment line) into a binary graph file.
+ *   Any other text on an edge line is rejected with its line number.
+ * - void Graph::setVertexNames(const std::vector<std::string_view>& names) / std::string_view vertexName(int v):
+ *   Optional vertex names, stored as a flat arena (offsets + characters) that is saved with the graph.
+ * - static Graph Graph::ingestDependencies(const std::string& path, int threads): Reads a text file of
+ *   "name -> name" lines (a line with a single name declares an isolated vertex, '#' starts a comment line)
+ *   in fixed-size blocks. Each block is parsed by all threads, which intern names through a NameTable.
+ *   Only one block of the file is held in memory. Ids are dense and numbered by first occurrence in the
+ *   file, so the result does not depend on the number of threads or their interleaving.
  * - void Graph::dfs(int source): Recursive method to perform DFS from a given vertex and populate 
  *   the topological order list.
  * - void Graph::dfs_explore(): Iterates through all vertices, performing DFS on unvisited nodes.
- * - void Graph::topologicalSorting(): Generates the topological order, mapping vertices to their corresponding 
- *   clothing items and printing the sorted order.
+ * - void Graph::topologicalOrder(std::vector<int>& order): Same ordering as dfs_explore, but with an explicit
+ *   stack instead of recursion. The order is written from the back (reverse postorder) into a caller-provided
+ *   vector, so deep graphs can't overflow the thread stack and no memory is allocated per vertex.
+ * - bool Graph::parallelTopologicalSort(std::vector<int>& order, std::vector<int>& level, int threads):
+ *   Multi-threaded Kahn's algorithm. In-degrees are counted in parallel, then the zero-in-degree frontier is
+ *   processed one level at a time, each level spread over all threads with atomic in-degree decrements.
+ *   Fills the order and the level (depth) of every vertex; returns false if the graph has a cycle.
+ * - int Graph::vertexCount() / std::int64_t Graph::edgeCount(): Number of vertices / frozen edges.
+ * - void Graph::forEachNeighbor(int u, F visit): Calls visit(v) for every edge u -> v of the frozen graph.
+ * - int Graph::stronglyConnectedComponents(std::vector<int>& component, bool parallel, int threads): Labels
+ *   every vertex with its strongly connected component and returns how many there are. The default is an
+ *   iterative Tarjan (one linear pass, no recursion); parallel = true trims the acyclic part and then runs
+ *   the forward-backward algorithm with independent subproblems spread over the threads.
+ * - Condensation Graph::condense(bool parallel, int threads): Collapses every component into a super-vertex,
+ *   topologically sorts the resulting DAG and returns the component of each vertex, a usable order of all
+ *   vertices (grouped by component) and the vertices of every cycle. topologicalOrder and dfs assume a DAG;
+ *   condense is the way to order cyclic inputs.
+ * - void Graph::topologicalSorting(): Generates the topological order, mapping vertices to their names
+ *   (the clothing items) and printing the sorted order.
+ *
+ * - IncrementalTopologicalOrder::IncrementalTopologicalOrder(Graph& graph): Starts from the DFS order of
+ *   graph. Throws std::invalid_argument if graph already has a cycle.
+ * - bool IncrementalTopologicalOrder::addEdge(int u, int v): Inserts u -> v (also into graph) and repairs
+ *   the order in time proportional to the affected region. Returns false and leaves everything untouched
+ *   if the edge would create a cycle.
+ * - int IncrementalTopologicalOrder::position(int v) / const std::vector<int>& order(): Current order.
+ * - DagExecutor::DagExecutor(Graph& graph): Throws std::invalid_argument if graph has a cycle.
+ * - void DagExecutor::setTask(int v, std::function<void()> task): Attaches the work of vertex v.
+ * - ExecutionReport DagExecutor::run(int threads): Executes every task once, each worker popping from its own
+ *   deque and stealing from the others when it runs dry. Idle workers sleep on a condition variable until a
+ *   task is released or the run ends. Per-vertex atomic counters track the unfinished predecessors.
+ *   Rethrows the first exception thrown by a task after the pool stops.
+ * - ReachabilityIndex::ReachabilityIndex(Graph& graph, std::int64_t closure_bytes): Throws
+ *   std::invalid_argument if graph has a cycle. When the transitive closure fits in closure_bytes it is
+ *   stored as one bitset per vertex, computed in reverse topological order with word-wide ORs (AVX2 when
+ *   the CPU has it, detected at run time), and queries are a single bit test. Larger graphs get an interval
+ *   labeling instead: every vertex keeps its level and two [low, rank] intervals (one from a DFS postorder,
+ *   one from the Kahn order) that must contain the interval of anything it reaches. Most negative queries
+ *   are answered by these labels in O(1); the rest run a DFS pruned by the same labels.
+ * - bool ReachabilityIndex::reaches(int u, int v): True if there is a path from u to v (u reaches itself).
+ *   The labeled mode reuses scratch buffers, so one index must not be queried from several threads.
+ *
+ * Binary graph file (native byte order, every section 8-byte aligned):
+ * - Header: magic "CSRGRAPH", version, byte order mark, vertex count V, edge count E, name arena size N.
+ * - Offsets: V + 1 int64 values; the edges of u are targets[offsets[u]..offsets[u+1]).
+ * - Targets: E int32 values, padded to a multiple of 8 bytes.
+ * - Names (only when N > 0): V + 1 int64 offsets into the following N bytes of characters.
  *
  * Example usage:
  * ```
- * Graph g;
+ * Graph g(9);
+ * g.setVertexNames({"undershorts", "socks", "shoes", ...});
  * g.addEdge(0, 3); // Add an edge from 'undershorts' to 'pants'
  * g.addEdge(0, 2); // Add an edge from 'undershorts' to 'shoes'
  * // Additional edges...
@@ -61,68 +140,1661 @@ Data Structures and Algorithms - Topological sorting
 #include <vector>
 #include <list>
 #include <unordered_map>
-#define VERT 9
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <memory>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <string_view>
+// GCC and Clang on x86 build the AVX2 kernel regardless of flags and use it when the CPU has AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GRAPH_SIMD_DISPATCH
+#define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define AVX2_TARGET
+#endif
+#if defined(__AVX2__) || defined(GRAPH_SIMD_DISPATCH)
+#include <immintrin.h>
+#endif
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedFile{
+    private:
+        const char* data;            // First byte of the mapping
+        std::size_t size;            // Length of the file in bytes
+#ifdef _WIN32
+        HANDLE file;
+        HANDLE mapping;
+#endif
+
+    public:
+        MappedFile(const std::string&);  // Maps the whole file read-only
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        const char* begin() const;
+        std::size_t length() const;
+};
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path){
+    data = nullptr;
+    size = 0;
+    mapping = nullptr;
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Can't open " + path);
+    LARGE_INTEGER file_size;
+    if(!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0){
+        CloseHandle(file);
+        throw std::runtime_error("Can't map " + path);
+    }
+    size = (std::size_t)file_size.QuadPart;
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping != nullptr)
+        data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(data == nullptr){
+        if(mapping != nullptr)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Can't map " + path);
+    }
+}
+
+MappedFile::~MappedFile(){
+    UnmapViewOfFile(data);
+    CloseHandle(mapping);
+    CloseHandle(file);
+}
+#else
+MappedFile::MappedFile(const std::string& path){
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if(descriptor < 0)
+        throw std::runtime_error("Can't open " + path);
+    struct stat status;
+    if(fstat(descriptor, &status) != 0 || status.st_size == 0){
+        close(descriptor);
+        throw std::runtime_error("Can't map " + path);
+    }
+    size = (std::size_t)status.st_size;
+    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);               // The mapping stays valid without the descriptor
+    if(address == MAP_FAILED)
+        throw std::runtime_error("Can't map " + path);
+    data = (const char*)address;
+}
+
+MappedFile::~MappedFile(){
+    munmap((void*)data, size);
+}
+#endif
+
+const char* MappedFile::begin() const{
+    return data;
+}
+
+std::size_t MappedFile::length() const{
+    return size;
+}
+
+struct NeighborCursor {
+    std::int64_t position;           // Next edge (raw CSR) or next byte (compressed) of the list
+    std::int64_t end;                // End of the list
+    int previous;                    // Last decoded neighbor (compressed lists store gaps)
+    bool first;                      // The next value is the zigzag-encoded first gap
+};
+
+struct GraphFileHeader {
+    char magic[8];                   // "CSRGRAPH"
+    std::uint32_t version;
+    std::uint32_t byte_order;        // GRAPH_FILE_BYTE_ORDER as written by the machine that saved the file
+    std::int64_t vertices;
+    std::int64_t edges;
+    std::int64_t name_bytes;         // Size of the name arena, 0 when the file has no names
+};
+
+class NameTable{
+    private:
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<std::string_view, int> ids;  // Keys point into keys below
+            std::deque<std::string> keys;                    // Owns the characters; never moves them
+        };
+        static const int SHARDS = 64;
+        Shard shards[SHARDS];
+        std::atomic<int> next_id;
+
+    public:
+        NameTable();
+        int intern(std::string_view);              // Id of a name, assigning the next dense id if it is new
+        int size() const;                          // Number of distinct names
+        std::vector<std::string_view> names();     // Names indexed by id
+};
+
+NameTable::NameTable(){
+    next_id = 0;
+}
+
+// Time complexity = O(length of the name) expected
+int NameTable::intern(std::string_view name){
+    Shard& shard = shards[std::hash<std::string_view>()(name) % SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::unordered_map<std::string_view, int>::iterator found = shard.ids.find(name);
+    if(found != shard.ids.end())
+        return found->second;
+    shard.keys.emplace_back(name);
+    int id = next_id.fetch_add(1, std::memory_order_relaxed);
+    shard.ids.emplace(shard.keys.back(), id);
+    return id;
+}
+
+// Time complexity = O(1)
+int NameTable::size() const{
+    return next_id.load(std::memory_order_relaxed);
+}
+
+// Time complexity = O(number of names)
+std::vector<std::string_view> NameTable::names(){
+    std::vector<std::string_view> by_id(size());
+    for(Shard& shard : shards)
+        for(const std::pair<const std::string_view, int>& entry : shard.ids)
+            by_id[entry.second] = entry.first;
+    return by_id;
+}
+
+const std::size_t INGEST_BLOCK_SIZE = 16 << 20;  // Bytes of the input file held in memory by the ingest
+const std::size_t DFS_STACK_RESERVE = 64;          // Frames reserved up front; deeper searches grow the stack
+
+const char GRAPH_FILE_MAGIC[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+const std::uint32_t GRAPH_FILE_VERSION = 1;
+const std::uint32_t GRAPH_FILE_BYTE_ORDER = 0x01020304;
+
+class Barrier{
+    private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        int threads;                 // Number of threads that must arrive before anyone is released
+        int waiting;                 // Threads that already arrived in the current generation
+        int generation;              // Incremented every time the barrier opens
+
+    public:
+        Barrier(int);
+        void wait();                 // Blocks until every thread has called wait
+};
+
+Barrier::Barrier(int threads){
+    this->threads = threads;
+    waiting = 0;
+    generation = 0;
+}
+
+void Barrier::wait(){
+    std::unique_lock<std::mutex> lock(mutex);
+    int arrival_generation = generation;
+    if(++waiting == threads){
+        waiting = 0;                 // Last thread to arrive opens the barrier for everyone
+        generation++;
+        condition.notify_all();
+    }
+    else
+        condition.wait(lock, [&]{ return generation != arrival_generation; });
+}
 
 class Graph{
     private:
-        std::vector<int> adj[VERT];  // Adjacency list for storing edges
-        bool visited[VERT];          // Array to keep track of visited nodes during DFS
-        std::list<int> topological_list;  // List to store the topological order
+        int vertices;                         // Number of vertices, fixed at construction
+        std::vector<int> edge_sources;        // Sources of the edges added since the last freeze
+        std::vector<int> edge_targets;        // Targets of the edges added since the last freeze
+        std::vector<std::int64_t> offset_storage;  // CSR arrays owned by the graph (empty when mapped)
+        std::vector<int> target_storage;
+        std::vector<std::int64_t> name_offset_storage;  // Name arena owned by the graph (empty when mapped)
+        std::vector<char> name_storage;
+        std::vector<unsigned char> byte_storage;  // Compressed adjacency lists (empty when not compressed)
+        std::unique_ptr<MappedFile> mapping;  // Binary graph file backing the arrays below, if any
+        bool compressed;                      // Adjacency lists are varint gaps in bytes instead of targets
+        std::int64_t edges;                   // Number of frozen edges
+        const std::int64_t* offsets;          // CSR offsets: edges of u are targets[offsets[u]..offsets[u+1]),
+                                              // or bytes[offsets[u]..offsets[u+1]) when compressed
+        const int* targets;                   // CSR targets: every adjacency list stored contiguously
+        const unsigned char* bytes;           // Compressed adjacency lists
+        const std::int64_t* name_offsets;     // Name of v is names[name_offsets[v]..name_offsets[v+1]), or null
+        const char* names;
+        std::vector<bool> visited;            // Keeps track of visited nodes during DFS
+        std::list<int> topological_list;      // List to store the topological order
+        std::vector<int> stack_vertex;        // Explicit DFS stack: vertex of each frame
+        std::vector<NeighborCursor> stack_cursor;  // Explicit DFS stack: where each frame resumes its list
 
     public:
-        Graph();                     // Constructor to initialize the graph
+        Graph(int);                  // Constructor to initialize a graph with a number of vertices
+        Graph(const std::string&);   // Maps a binary graph file as the adjacency storage
+        void validate() const;       // Full check of the CSR arrays and the name arena
         void addEdge(int, int);      // Adds a directed edge from u to v
+        void freeze();               // Builds the CSR arrays from the pending edges
+        void compress();             // Switches to delta + varint compressed adjacency lists
+        void saveBinary(const std::string&);  // Writes the graph as a binary graph file
+        static void convertEdgeList(const std::string&, const std::string&);  // Text edge list to binary file
+        void setVertexNames(const std::vector<std::string_view>&);  // Stores the names in a flat arena
+        static Graph ingestDependencies(const std::string&, int = 0);  // Parallel "name -> name" ingest
+        bool hasNames() const;       // True if the graph has a name table
+        std::string_view vertexName(int) const;  // Name of a vertex, empty without a name table
         void dfs(int);               // Recursive DFS function to explore the graph
         void dfs_explore();          // Initiates DFS from all unvisited nodes
+        void topologicalOrder(std::vector<int>&);  // Iterative DFS writing the topological order into a vector
+        bool parallelTopologicalSort(std::vector<int>&, std::vector<int>&, int = 0);  // Level-synchronous Kahn
+        int vertexCount() const;     // Number of vertices
+        std::int64_t edgeCount() const;  // Number of frozen edges
+        template <typename F>
+        void forEachNeighbor(int, F) const;  // Visits the targets of every frozen edge leaving a vertex
+        NeighborCursor firstNeighbor(int) const;           // Cursor at the start of a vertex's list
+        bool nextNeighbor(NeighborCursor&, int&) const;    // Decodes the next neighbor, false at the end
+        int stronglyConnectedComponents(std::vector<int>&, bool = false, int = 0);  // Labels the SCCs
+        struct Condensation condense(bool = false, int = 0);  // Orders a possibly cyclic graph via its SCCs
         void topologicalSorting();   // Performs topological sorting and prints the order
+
+    private:
+        int tarjanComponents(std::vector<int>&);                   // Iterative Tarjan
+        int forwardBackwardComponents(std::vector<int>&, int);     // Trim + parallel forward-backward
+        void releaseMapping();                                     // Copies the names out and unmaps the file
 };
 
-Graph::Graph(){
-    for(int i = 0; i < VERT; i++)
-        visited[i] = false;          // Initialize all vertices as not visited
+struct Condensation {
+    int components;                          // Number of strongly connected components
+    std::vector<int> component;              // Component of each vertex
+    std::vector<int> componentOrder;         // Components in topological order of the condensation
+    std::vector<int> order;                  // Every vertex, grouped by component, components in that order
+    std::vector<std::vector<int>> cycles;    // Vertices of every component that contains a cycle
+    Graph dag;                               // The condensation: one vertex per component
+};
+
+Graph::Graph(int vertices){
+    if(vertices < 0)
+        throw std::invalid_argument("Number of vertices can't be negative");
+    this->vertices = vertices;
+    offset_storage.assign(vertices + 1, 0);  // No edges yet: every adjacency list is empty
+    offsets = offset_storage.data();
+    targets = target_storage.data();
+    bytes = nullptr;
+    compressed = false;
+    edges = 0;
+    name_offsets = nullptr;
+    names = nullptr;
+    visited.assign(vertices, false); // Initialize all vertices as not visited
+}
+
+// Time complexity = O(1): the arrays are used in place, see validate() for the full check
+Graph::Graph(const std::string& path){
+    mapping.reset(new MappedFile(path));
+    const char* base = mapping->begin();
+    std::size_t length = mapping->length();
+    GraphFileHeader header;
+    if(length < sizeof(header))
+        throw std::runtime_error(path + " isn't a graph file");
+    std::memcpy(&header, base, sizeof(header));
+    if(std::memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != GRAPH_FILE_VERSION)
+        throw std::runtime_error(path + " isn't a graph file");
+    if(header.byte_order != GRAPH_FILE_BYTE_ORDER)
+        throw std::runtime_error(path + " was written with another byte order");
+    if(header.vertices < 0 || header.vertices > INT32_MAX || header.edges < 0 || header.name_bytes < 0)
+        throw std::runtime_error(path + " has an invalid header");
+
+    // Every size is bounded by what is left of the file before it is multiplied, so nothing can wrap
+    std::uint64_t offsets_at = sizeof(header);
+    std::uint64_t targets_at = offsets_at + (header.vertices + 1) * sizeof(std::int64_t);
+    if(targets_at > length || (std::uint64_t)header.edges > (length - targets_at) / sizeof(int))
+        throw std::runtime_error(path + " is truncated");
+    std::uint64_t names_at = targets_at + (header.edges * sizeof(int) + 7) / 8 * 8;
+    if(header.name_bytes > 0){
+        std::uint64_t arena_at = names_at + (header.vertices + 1) * sizeof(std::int64_t);
+        if(arena_at > length || (std::uint64_t)header.name_bytes > length - arena_at)
+            throw std::runtime_error(path + " is truncated");
+    }
+
+    vertices = (int)header.vertices;
+    offsets = (const std::int64_t*)(base + offsets_at);
+    targets = (const int*)(base + targets_at);
+    if(offsets[0] != 0 || offsets[vertices] != header.edges)
+        throw std::runtime_error(path + " has invalid offsets");
+    if(header.name_bytes > 0){
+        const std::int64_t* name_at = (const std::int64_t*)(base + names_at);
+        if(name_at[0] != 0 || name_at[vertices] != header.name_bytes)
+            throw std::runtime_error(path + " has invalid name offsets");
+    }
+    bytes = nullptr;
+    compressed = false;
+    edges = header.edges;
+    name_offsets = header.name_bytes > 0 ? (const std::int64_t*)(base + names_at) : nullptr;
+    names = header.name_bytes > 0 ? base + names_at + (header.vertices + 1) * sizeof(std::int64_t) : nullptr;
+    visited.assign(vertices, false);
+}
+
+// Time complexity = O(V + E)
+void Graph::validate() const{
+    std::int64_t end = compressed ? (std::int64_t)byte_storage.size() : edges;
+    if(offsets[0] != 0 || offsets[vertices] != end)
+        throw std::runtime_error("Graph has invalid offsets");
+    for(int v = 0; v < vertices; v++)
+        if(offsets[v] > offsets[v + 1])
+            throw std::runtime_error("Graph has invalid offsets");
+    if(!compressed)
+        for(std::int64_t e = 0; e < edges; e++)
+            if(targets[e] < 0 || targets[e] >= vertices)
+                throw std::runtime_error("Graph has an edge to a vertex that doesn't exist");
+    if(name_offsets != nullptr){
+        if(name_offsets[0] != 0)
+            throw std::runtime_error("Graph has invalid name offsets");
+        for(int v = 0; v < vertices; v++)
+            if(name_offsets[v] > name_offsets[v + 1])
+                throw std::runtime_error("Graph has invalid name offsets");
+    }
+}
+
+// Time complexity = O(1)
+int Graph::vertexCount() const{
+    return vertices;
+}
+
+// Time complexity = O(1)
+std::int64_t Graph::edgeCount() const{
+    return edges;
+}
+
+// Time complexity = O(out-degree)
+template <typename F>
+void Graph::forEachNeighbor(int u, F visit) const{
+    if(!compressed){
+        for(std::int64_t e = offsets[u]; e < offsets[u + 1]; e++)
+            visit(targets[e]);
+        return;
+    }
+    NeighborCursor cursor = firstNeighbor(u);
+    int v;
+    while(nextNeighbor(cursor, v))
+        visit(v);
+}
+
+// Time complexity = O(1)
+NeighborCursor Graph::firstNeighbor(int u) const{
+    return NeighborCursor{offsets[u], offsets[u + 1], u, true};
 }
 
+// Time complexity = O(1)
+bool Graph::nextNeighbor(NeighborCursor& cursor, int& v) const{
+    if(cursor.position >= cursor.end)
+        return false;
+    if(!compressed){
+        v = targets[cursor.position++];
+        return true;
+    }
+    std::uint32_t value = bytes[cursor.position++];
+    if(value >= 0x80){               // Multi-byte varint: 7 bits per byte, low bits first
+        value &= 0x7f;
+        int shift = 7;
+        unsigned char byte;
+        do{
+            byte = bytes[cursor.position++];
+            value |= (std::uint32_t)(byte & 0x7f) << shift;
+            shift += 7;
+        } while(byte & 0x80);
+    }
+    if(cursor.first){
+        cursor.first = false;        // First gap is relative to the source and may be negative
+        v = (int)((std::int64_t)cursor.previous + ((value & 1) ? -(std::int64_t)(value >> 1) - 1 : (std::int64_t)(value >> 1)));
+    }
+    else
+        v = cursor.previous + (int)value;
+    cursor.previous = v;
+    return true;
+}
+
+// Time complexity = O(1) amortized
 void Graph::addEdge(int u, int v){
-    adj[u].push_back(v);             // Add v to the adjacency list of u
+    if(u < 0 || u >= vertices || v < 0 || v >= vertices)
+        throw std::out_of_range("Vertex doesn't exist");
+    edge_sources.push_back(u);       // Edge is kept pending until the next freeze
+    edge_targets.push_back(v);
+}
+
+// Time complexity = O(V + E)
+void Graph::freeze(){
+    if(edge_sources.empty())
+        return;                      // CSR arrays are already up to date
+
+    // Counting sort by source: count the out-degree of every vertex (old edges + pending ones)
+    std::vector<std::int64_t> new_offsets(vertices + 1, 0);
+    for(int u = 0; u < vertices; u++){
+        if(compressed)
+            forEachNeighbor(u, [&](int){ new_offsets[u + 1]++; });
+        else
+            new_offsets[u + 1] = offsets[u + 1] - offsets[u];
+    }
+    for(int u : edge_sources)
+        new_offsets[u + 1]++;
+    for(int u = 0; u < vertices; u++)
+        new_offsets[u + 1] += new_offsets[u];
+
+    // Old edges keep their place and pending edges follow in insertion order,
+    // so each adjacency list has the same order that push_back would give
+    std::vector<int> new_targets(new_offsets[vertices]);
+    std::vector<std::int64_t> cursor(new_offsets.begin(), new_offsets.end() - 1);
+    for(int u = 0; u < vertices; u++)
+        forEachNeighbor(u, [&](int v){ new_targets[cursor[u]++] = v; });
+    for(std::size_t i = 0; i < edge_sources.size(); i++)
+        new_targets[cursor[edge_sources[i]]++] = edge_targets[i];
+
+    bool was_compressed = compressed;
+    offset_storage.swap(new_offsets);
+    target_storage.swap(new_targets);
+    std::vector<unsigned char>().swap(byte_storage);
+    offsets = offset_storage.data();
+    targets = target_storage.data();
+    bytes = nullptr;
+    compressed = false;
+    edges = offsets[vertices];
+    std::vector<int>().swap(edge_sources);  // Release the pending buffers
+    std::vector<int>().swap(edge_targets);
+    releaseMapping();
+    if(was_compressed)
+        compress();                  // Stay in compressed mode
+}
+
+// Time complexity = O(V + E log(max out-degree))
+void Graph::compress(){
+    freeze();
+    if(compressed)
+        return;
+    std::vector<std::int64_t> new_offsets(vertices + 1, 0);
+    std::vector<unsigned char> new_bytes;
+    new_bytes.reserve(edges + edges / 4);  // Most gaps of a sorted list fit in one or two bytes
+    std::vector<int> list;
+    auto put = [&](std::uint32_t value){
+        while(value >= 0x80){
+            new_bytes.push_back((unsigned char)(value | 0x80));
+            value >>= 7;
+        }
+        new_bytes.push_back((unsigned char)value);
+    };
+    for(int u = 0; u < vertices; u++){
+        list.assign(targets + offsets[u], targets + offsets[u + 1]);
+        std::sort(list.begin(), list.end());
+        int previous = u;
+        for(std::size_t i = 0; i < list.size(); i++){
+            if(i == 0){
+                std::int64_t gap = (std::int64_t)list[0] - u;  // Zigzag: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+                put(gap >= 0 ? (std::uint32_t)(gap * 2) : (std::uint32_t)(-gap * 2 - 1));
+            }
+            else
+                put((std::uint32_t)(list[i] - previous));
+            previous = list[i];
+        }
+        new_offsets[u + 1] = new_bytes.size();
+    }
+    new_bytes.shrink_to_fit();
+
+    offset_storage.swap(new_offsets);
+    byte_storage.swap(new_bytes);
+    std::vector<int>().swap(target_storage);
+    offsets = offset_storage.data();
+    bytes = byte_storage.data();
+    targets = nullptr;
+    compressed = true;
+    releaseMapping();
+}
+
+void Graph::releaseMapping(){
+    if(mapping && name_offsets != nullptr){
+        // The adjacency no longer lives in the file; keep a private copy of the names before unmapping
+        name_offset_storage.assign(name_offsets, name_offsets + vertices + 1);
+        name_storage.assign(names, names + name_offsets[vertices]);
+        name_offsets = name_offset_storage.data();
+        names = name_storage.data();
+    }
+    mapping.reset();
+}
+
+// Time complexity = O(V + E)
+void Graph::saveBinary(const std::string& path){
+    freeze();
+    std::ofstream file(path, std::ios::binary);
+    if(!file)
+        throw std::runtime_error("Can't create " + path);
+    GraphFileHeader header;
+    std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.byte_order = GRAPH_FILE_BYTE_ORDER;
+    header.vertices = vertices;
+    header.edges = edges;
+    header.name_bytes = hasNames() ? name_offsets[vertices] : 0;
+
+    const char padding[8] = {0};
+    file.write((const char*)&header, sizeof(header));
+    if(!compressed){
+        file.write((const char*)offsets, (vertices + 1) * sizeof(std::int64_t));
+        file.write((const char*)targets, header.edges * sizeof(int));
+    }
+    else{
+        // The file always holds raw CSR arrays: decode the lists while writing them
+        std::int64_t edge_offset = 0;
+        file.write((const char*)&edge_offset, sizeof(edge_offset));
+        for(int u = 0; u < vertices; u++){
+            forEachNeighbor(u, [&](int){ edge_offset++; });
+            file.write((const char*)&edge_offset, sizeof(edge_offset));
+        }
+        std::vector<int> list;
+        for(int u = 0; u < vertices; u++){
+            list.clear();
+            forEachNeighbor(u, [&](int v){ list.push_back(v); });
+            file.write((const char*)list.data(), list.size() * sizeof(int));
+        }
+    }
+    file.write(padding, (8 - header.edges * sizeof(int) % 8) % 8);
+    if(header.name_bytes > 0){
+        file.write((const char*)name_offsets, (vertices + 1) * sizeof(std::int64_t));
+        file.write(names, header.name_bytes);
+    }
+    if(!file.flush())
+        throw std::runtime_error("Can't write " + path);
+}
+
+// Time complexity = O(V + E)
+void Graph::convertEdgeList(const std::string& text_path, const std::string& binary_path){
+    std::ifstream file(text_path);
+    if(!file)
+        throw std::runtime_error("Can't open " + text_path);
+    std::vector<int> sources, destinations;
+    int vertex_count = 0;
+    std::string line;
+    long line_number = 0;
+    while(std::getline(file, line)){
+        line_number++;
+        const char* cursor = line.c_str();
+        while(*cursor == ' ' || *cursor == '\t')
+            cursor++;
+        if(*cursor == '\0' || *cursor == '#' || *cursor == '\r')
+            continue;                // Blank or comment line
+        char* middle;
+        char* end;
+        long u = std::strtol(cursor, &middle, 10);
+        long v = std::strtol(middle, &end, 10);
+        const char* rest = end;
+        while(*rest == ' ' || *rest == '\t' || *rest == '\r')
+            rest++;
+        if(middle == cursor || end == middle || *rest != '\0' ||
+           u < 0 || v < 0 || u >= INT32_MAX || v >= INT32_MAX)
+            throw std::runtime_error("Invalid edge at " + text_path + ":" + std::to_string(line_number) + ": " + line);
+        sources.push_back((int)u);
+        destinations.push_back((int)v);
+        vertex_count = std::max(vertex_count, (int)std::max(u, v) + 1);
+    }
+    Graph graph(vertex_count);
+    graph.edge_sources.swap(sources);  // Hand the edges over without copying them
+    graph.edge_targets.swap(destinations);
+    graph.saveBinary(binary_path);
+}
+
+// Time complexity = O(V + total length of the names)
+void Graph::setVertexNames(const std::vector<std::string_view>& new_names){
+    std::vector<std::int64_t> new_offsets(vertices + 1, 0);
+    std::vector<char> new_storage;
+    for(int v = 0; v < vertices; v++){
+        if(v < (int)new_names.size())  // Vertices without a name get an empty one
+            new_storage.insert(new_storage.end(), new_names[v].begin(), new_names[v].end());
+        new_offsets[v + 1] = new_storage.size();
+    }
+    name_offset_storage.swap(new_offsets);
+    name_storage.swap(new_storage);
+    name_offsets = name_offset_storage.data();
+    names = name_storage.data();
+}
+
+// Time complexity = O(file size / threads) plus the interning contention and an O(E) renumbering
+Graph Graph::ingestDependencies(const std::string& path, int threads){
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
+        throw std::runtime_error("Can't open " + path);
+    if(threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    NameTable table;
+    std::vector<int> sources, destinations;
+    std::vector<std::vector<int>> local_sources(threads), local_destinations(threads);
+    std::vector<std::vector<int>> local_order(threads);  // Table ids in the order each slice met them
+    std::vector<int> renumber;           // Table id -> final id, -1 until the name is first met
+    int next_vertex = 0;
+    std::vector<std::exception_ptr> errors(threads);
+
+    auto trim = [](const char* begin, const char* end){
+        while(begin < end && (*begin == ' ' || *begin == '\t'))
+            begin++;
+        while(end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+            end--;
+        return std::string_view(begin, end - begin);
+    };
+
+    // Parses the complete lines in [begin, end) into the edge buffers of thread t
+    auto parse = [&](int t, const char* begin, const char* end){
+        try{
+            while(begin < end){
+                const char* line_end = (const char*)std::memchr(begin, '\n', end - begin);
+                if(line_end == nullptr)
+                    line_end = end;
+                std::string_view line = trim(begin, line_end);
+                begin = line_end + 1;
+                if(line.empty() || line[0] == '#')
+                    continue;            // Blank or comment line
+                std::size_t arrow = line.find("->");
+                if(arrow == std::string_view::npos){
+                    local_order[t].push_back(table.intern(line));  // Vertex without dependencies
+                    continue;
+                }
+                std::string_view from = trim(line.data(), line.data() + arrow);
+                std::string_view to = trim(line.data() + arrow + 2, line.data() + line.size());
+                if(from.empty() || to.empty())
+                    throw std::runtime_error("Invalid dependency in " + path + ": " + std::string(line));
+                int u = table.intern(from);
+                int v = table.intern(to);
+                local_order[t].push_back(u);
+                local_order[t].push_back(v);
+                local_sources[t].push_back(u);
+                local_destinations[t].push_back(v);
+            }
+        }
+        catch(...){
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<char> buffer(INGEST_BLOCK_SIZE);
+    std::size_t carried = 0;             // Bytes of an incomplete last line kept from the previous block
+    bool end_of_file = false;
+    while(!end_of_file){
+        file.read(buffer.data() + carried, buffer.size() - carried);
+        std::size_t filled = carried + file.gcount();
+        end_of_file = !file;
+
+        // Only complete lines are parsed; the tail of the block waits for the next read
+        std::size_t usable = filled;
+        if(!end_of_file){
+            while(usable > 0 && buffer[usable - 1] != '\n')
+                usable--;
+            if(usable == 0){
+                buffer.resize(buffer.size() * 2);  // A single line longer than the block
+                carried = filled;
+                continue;
+            }
+        }
+
+        // Split the block into one slice per thread, each ending at a line boundary
+        std::vector<std::thread> pool;
+        const char* slice_begin = buffer.data();
+        const char* block_end = buffer.data() + usable;
+        for(int t = 0; t < threads; t++){
+            const char* slice_end = t == threads - 1 ? block_end : buffer.data() + usable * (t + 1) / threads;
+            if(slice_end < slice_begin)
+                slice_end = slice_begin;
+            while(slice_end > slice_begin && slice_end < block_end && slice_end[-1] != '\n')
+                slice_end++;
+            if(t == threads - 1)
+                parse(t, slice_begin, slice_end);
+            else
+                pool.emplace_back(parse, t, slice_begin, slice_end);
+            slice_begin = slice_end;
+        }
+        for(std::thread& thread : pool)
+            thread.join();
+        // Final ids follow the first occurrence in the file, whichever thread interned the name first
+        renumber.resize(table.size(), -1);
+        for(int t = 0; t < threads; t++){
+            if(errors[t])
+                std::rethrow_exception(errors[t]);
+            for(int id : local_order[t])
+                if(renumber[id] < 0)
+                    renumber[id] = next_vertex++;
+            for(int id : local_sources[t])
+                sources.push_back(renumber[id]);
+            for(int id : local_destinations[t])
+                destinations.push_back(renumber[id]);
+            local_order[t].clear();
+            local_sources[t].clear();
+            local_destinations[t].clear();
+        }
+
+        carried = filled - usable;
+        std::memmove(buffer.data(), buffer.data() + usable, carried);
+    }
+
+    std::vector<std::string_view> by_table_id = table.names();
+    std::vector<std::string_view> by_vertex(next_vertex);
+    for(int id = 0; id < (int)by_table_id.size(); id++)
+        by_vertex[renumber[id]] = by_table_id[id];
+    Graph graph(next_vertex);
+    graph.edge_sources.swap(sources);    // Hand the edges over without copying them
+    graph.edge_targets.swap(destinations);
+    graph.setVertexNames(by_vertex);
+    graph.freeze();
+    return graph;
+}
+
+// Time complexity = O(1)
+bool Graph::hasNames() const{
+    return name_offsets != nullptr;
+}
+
+// Time complexity = O(1)
+std::string_view Graph::vertexName(int v) const{
+    if(name_offsets == nullptr)
+        return std::string_view();
+    return std::string_view(names + name_offsets[v], name_offsets[v + 1] - name_offsets[v]);
 }
 
 void Graph::dfs(int source){
     visited[source] = true;          // Mark the current node as visited
-    for(int v : adj[source]){        // Explore all adjacent nodes
+    forEachNeighbor(source, [&](int v){  // Explore all adjacent nodes
         if(!visited[v])
             dfs(v);                  // Recursively visit unvisited adjacent nodes
-    }
+    });
     topological_list.push_front(source);  // Add the node to the front of the list to maintain topological order
 }
 
 void Graph::dfs_explore(){
-    for(int i = 0; i < VERT; i++)
+    freeze();                        // Make sure the CSR arrays contain every edge
+    visited.assign(vertices, false);
+    topological_list.clear();
+    for(int i = 0; i < vertices; i++)
         if(!visited[i]) dfs(i);      // Start DFS for each unvisited vertex
 }
 
+// Time complexity = O(V + E)
+void Graph::topologicalOrder(std::vector<int>& order){
+    freeze();
+    order.resize(vertices);          // No reallocation when the caller already sized the vector
+    stack_vertex.reserve(DFS_STACK_RESERVE);  // Sized by the deepest search, not by V
+    stack_cursor.reserve(DFS_STACK_RESERVE);
+    visited.assign(vertices, false);
+
+    int back = vertices;             // Reverse postorder: finished vertices are written from the back
+    for(int root = 0; root < vertices; root++){
+        if(visited[root])
+            continue;
+        visited[root] = true;
+        stack_vertex.push_back(root);
+        stack_cursor.push_back(firstNeighbor(root));
+        while(!stack_vertex.empty()){
+            int u = stack_vertex.back();
+            int v;
+            if(nextNeighbor(stack_cursor.back(), v)){  // Resume u's adjacency list where it stopped
+                if(!visited[v]){
+                    visited[v] = true;
+                    stack_vertex.push_back(v);
+                    stack_cursor.push_back(firstNeighbor(v));
+                }
+            }
+            else{
+                order[--back] = u;   // Every successor of u is finished
+                stack_vertex.pop_back();
+                stack_cursor.pop_back();
+            }
+        }
+    }
+}
+
+// Time complexity = O((V + E) / threads + levels) with enough parallelism per level
+bool Graph::parallelTopologicalSort(std::vector<int>& order, std::vector<int>& level, int threads){
+    freeze();
+    if(threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    order.resize(vertices);
+    level.assign(vertices, -1);      // Vertices on a cycle are never reached and keep level -1
+
+    std::vector<std::atomic<int>> in_degree(vertices);
+    std::vector<std::vector<int>> next(threads);  // Vertices released by each thread during the current level
+    Barrier barrier(threads);
+    std::int64_t frontier_begin = 0; // The current level is the slice order[frontier_begin, frontier_end)
+    std::int64_t frontier_end = 0;
+    int depth = 0;
+
+    auto worker = [&](int t){
+        std::int64_t first = (std::int64_t)vertices * t / threads;
+        std::int64_t last = (std::int64_t)vertices * (t + 1) / threads;
+        for(std::int64_t v = first; v < last; v++)
+            in_degree[v].store(0, std::memory_order_relaxed);
+        barrier.wait();
+        for(std::int64_t u = first; u < last; u++)
+            forEachNeighbor(u, [&](int v){ in_degree[v].fetch_add(1, std::memory_order_relaxed); });
+        barrier.wait();
+        for(std::int64_t v = first; v < last; v++)
+            if(in_degree[v].load(std::memory_order_relaxed) == 0){
+                level[v] = 0;
+                next[t].push_back(v);
+            }
+        barrier.wait();
+
+        while(true){
+            if(t == 0){
+                // Append the vertices released in the previous level; they form the new frontier
+                frontier_begin = frontier_end;
+                for(std::vector<int>& released : next){
+                    std::copy(released.begin(), released.end(), order.begin() + frontier_end);
+                    frontier_end += released.size();
+                    released.clear();
+                }
+            }
+            barrier.wait();
+            if(frontier_begin == frontier_end)
+                break;               // Every thread sees the same frontier after the barrier
+
+            // The barriers order these relaxed decrements with the reads of the next level
+            std::int64_t size = frontier_end - frontier_begin;
+            for(std::int64_t i = frontier_begin + size * t / threads; i < frontier_begin + size * (t + 1) / threads; i++){
+                forEachNeighbor(order[i], [&](int v){
+                    if(in_degree[v].fetch_sub(1, std::memory_order_relaxed) == 1){
+                        level[v] = depth + 1;  // Only the thread that removed the last edge writes v
+                        next[t].push_back(v);
+                    }
+                });
+            }
+            barrier.wait();
+            if(t == 0)
+                depth++;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for(int t = 1; t < threads; t++)
+        pool.emplace_back(worker, t);
+    worker(0);                       // The calling thread works as thread 0
+    for(std::thread& thread : pool)
+        thread.join();
+
+    return frontier_end == vertices; // A cycle leaves vertices that never reach in-degree zero
+}
+
 void Graph::topologicalSorting(){
     bool aux_print = false;          // Helper variable for formatting output with " -> "
-    std::unordered_map<int, std::string> matchingElements = {
-        {0, "undershorts"}, {1, "socks"}, {2, "shoes"},
-        {3, "pants"}, {4, "watch"}, {5, "belt"},
-        {6, "shirt"}, {7, "tie"}, {8, "jacket"}
+    std::vector<int> order;
+    topologicalOrder(order);         // Perform the iterative DFS and fill order
+
+    std::cout << "Order to wear clothes:\n";
+    for(int elem : order){
+        if(aux_print)
+            std::cout << " -> ";     // Print separator before every element but the first
+        aux_print = true;
+        if(hasNames())
+            std::cout << vertexName(elem);  // Names come from the flat arena, no hashing per lookup
+        else
+            std::cout << elem;
+    }
+}
+
+// Time complexity = O(V + E)
+int Graph::stronglyConnectedComponents(std::vector<int>& component, bool parallel, int threads){
+    freeze();
+    if(parallel)
+        return forwardBackwardComponents(component, threads);
+    return tarjanComponents(component);
+}
+
+// Time complexity = O(V + E)
+int Graph::tarjanComponents(std::vector<int>& component){
+    std::vector<int> index(vertices, -1);    // DFS discovery index, -1 while undiscovered
+    std::vector<int> low(vertices);          // Smallest index reachable through the DFS subtree
+    std::vector<int> scc_stack;              // Vertices whose component isn't known yet
+    std::vector<bool> on_stack(vertices, false);
+    stack_vertex.reserve(DFS_STACK_RESERVE);
+    stack_cursor.reserve(DFS_STACK_RESERVE);
+    component.assign(vertices, -1);
+    int next_index = 0;
+    int components = 0;
+
+    for(int root = 0; root < vertices; root++){
+        if(index[root] != -1)
+            continue;
+        stack_vertex.push_back(root);
+        stack_cursor.push_back(firstNeighbor(root));
+        index[root] = low[root] = next_index++;
+        scc_stack.push_back(root);
+        on_stack[root] = true;
+        while(!stack_vertex.empty()){
+            int u = stack_vertex.back();
+            int v;
+            if(nextNeighbor(stack_cursor.back(), v)){
+                if(index[v] == -1){
+                    stack_vertex.push_back(v);  // "Recursive call" on v
+                    stack_cursor.push_back(firstNeighbor(v));
+                    index[v] = low[v] = next_index++;
+                    scc_stack.push_back(v);
+                    on_stack[v] = true;
+                }
+                else if(on_stack[v])
+                    low[u] = std::min(low[u], index[v]);
+            }
+            else{
+                stack_vertex.pop_back();
+                stack_cursor.pop_back();
+                if(low[u] == index[u]){
+                    // u is the root of a component: everything above it on the stack belongs to it
+                    int w;
+                    do{
+                        w = scc_stack.back();
+                        scc_stack.pop_back();
+                        on_stack[w] = false;
+                        component[w] = components;
+                    } while(w != u);
+                    components++;
+                }
+                if(!stack_vertex.empty())
+                    low[stack_vertex.back()] = std::min(low[stack_vertex.back()], low[u]);
+            }
+        }
+    }
+    return components;
+}
+
+// Time complexity = O(V + E) for the trim, then O((V + E) * log V) expected for forward-backward
+int Graph::forwardBackwardComponents(std::vector<int>& component, int threads){
+    if(threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    component.assign(vertices, -1);
+
+    // Reverse adjacency in CSR form, used by the backward searches and the trim
+    std::vector<std::int64_t> reverse_offsets(vertices + 1, 0);
+    std::vector<int> in_degree(vertices), out_degree(vertices, 0), trimmed;
+    for(int u = 0; u < vertices; u++)
+        forEachNeighbor(u, [&](int v){
+            reverse_offsets[v + 1]++;
+            out_degree[u]++;
+        });
+    for(int v = 0; v < vertices; v++)
+        reverse_offsets[v + 1] += reverse_offsets[v];
+    std::vector<int> reverse_targets(edges);
+    {
+        std::vector<std::int64_t> cursor(reverse_offsets.begin(), reverse_offsets.end() - 1);
+        for(int u = 0; u < vertices; u++)
+            forEachNeighbor(u, [&](int v){ reverse_targets[cursor[v]++] = u; });
+    }
+
+    // Trim: a vertex without remaining predecessors or successors is a component on its own
+    std::atomic<int> components(0);
+    for(int v = 0; v < vertices; v++){
+        in_degree[v] = reverse_offsets[v + 1] - reverse_offsets[v];
+        if(in_degree[v] == 0 || out_degree[v] == 0){
+            component[v] = components++;
+            trimmed.push_back(v);
+        }
+    }
+    for(std::size_t i = 0; i < trimmed.size(); i++){
+        int u = trimmed[i];
+        forEachNeighbor(u, [&](int v){
+            if(component[v] == -1 && --in_degree[v] == 0){
+                component[v] = components++;
+                trimmed.push_back(v);
+            }
+        });
+        for(std::int64_t e = reverse_offsets[u]; e < reverse_offsets[u + 1]; e++){
+            int v = reverse_targets[e];
+            if(component[v] == -1 && --out_degree[v] == 0){
+                component[v] = components++;
+                trimmed.push_back(v);
+            }
+        }
+    }
+
+    // Forward-backward on what is left. A task owns the vertices of one color; tasks never share vertices,
+    // so they run concurrently. Colors are only read across tasks, hence the relaxed atomics.
+    std::vector<std::atomic<int>> color(vertices);
+    std::vector<unsigned char> mark(vertices, 0);  // 1 = reached forward, 2 = reached backward
+    std::atomic<int> next_color(1);
+    std::vector<std::pair<int, std::vector<int>>> tasks(1);
+    for(int v = 0; v < vertices; v++){
+        color[v].store(component[v] == -1 ? 0 : -1, std::memory_order_relaxed);
+        if(component[v] == -1)
+            tasks[0].second.push_back(v);
+    }
+    if(tasks[0].second.empty())
+        return components;
+
+    std::mutex task_mutex;
+    std::condition_variable task_ready;
+    int active = 0;                              // Tasks being processed right now
+
+    // Breadth-first search restricted to one color; adjacency(u, f) calls f on the neighbors of u
+    auto search = [&](int pivot, int task_color, unsigned char bit, auto adjacency, std::vector<int>& queue){
+        queue.assign(1, pivot);
+        mark[pivot] |= bit;
+        for(std::size_t i = 0; i < queue.size(); i++){
+            adjacency(queue[i], [&](int v){
+                // Check the color first: marks of vertices owned by other tasks must not be read
+                if(color[v].load(std::memory_order_relaxed) == task_color && !(mark[v] & bit)){
+                    mark[v] |= bit;
+                    queue.push_back(v);
+                }
+            });
+        }
+    };
+    auto successors = [&](int u, auto visit){ forEachNeighbor(u, visit); };
+    auto predecessors = [&](int u, auto visit){
+        for(std::int64_t e = reverse_offsets[u]; e < reverse_offsets[u + 1]; e++)
+            visit(reverse_targets[e]);
     };
 
-    dfs_explore();                   // Perform DFS and fill topological_list
+    auto worker = [&](){
+        std::vector<int> queue;
+        std::unique_lock<std::mutex> lock(task_mutex);
+        while(true){
+            task_ready.wait(lock, [&]{ return !tasks.empty() || active == 0; });
+            if(tasks.empty())
+                return;              // No task left and nobody can create one
+            std::pair<int, std::vector<int>> task = std::move(tasks.back());
+            tasks.pop_back();
+            active++;
+            lock.unlock();
 
-    std::cout << "Order to wear clothes:\n";
-    for(int elem : topological_list){
-        if(aux_print) 
-            std::cout << " -> " << matchingElements[elem];  // Print element with separator
-        else{
-            std::cout << matchingElements[elem];  // Print the first element without separator
-            aux_print = true;  // Set flag to true to use separator for subsequent elements
+            int task_color = task.first;
+            std::vector<int>& members = task.second;
+            search(members[0], task_color, 1, successors, queue);
+            search(members[0], task_color, 2, predecessors, queue);
+
+            // Reached both ways = the pivot's component; the three other parts become new tasks
+            int scc = components++;
+            int part_color[3] = {next_color++, next_color++, next_color++};
+            std::vector<int> parts[3];
+            for(int v : members){
+                if(mark[v] == 3){
+                    component[v] = scc;
+                    color[v].store(-1, std::memory_order_relaxed);
+                }
+                else{
+                    int part = mark[v];  // 0 = neither, 1 = forward only, 2 = backward only
+                    color[v].store(part_color[part], std::memory_order_relaxed);
+                    parts[part].push_back(v);
+                }
+                mark[v] = 0;
+            }
+
+            lock.lock();
+            for(int part = 0; part < 3; part++)
+                if(!parts[part].empty())
+                    tasks.emplace_back(part_color[part], std::move(parts[part]));
+            active--;
+            task_ready.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for(int t = 1; t < threads; t++)
+        pool.emplace_back(worker);
+    worker();
+    for(std::thread& thread : pool)
+        thread.join();
+    return components;
+}
+
+// Time complexity = O(V + E)
+Condensation Graph::condense(bool parallel, int threads){
+    std::vector<int> component;
+    int components = stronglyConnectedComponents(component, parallel, threads);
+
+    // Group the vertices by component (counting sort)
+    std::vector<int> first(components + 1, 0), members(vertices);
+    for(int v = 0; v < vertices; v++)
+        first[component[v] + 1]++;
+    for(int c = 0; c < components; c++)
+        first[c + 1] += first[c];
+    {
+        std::vector<int> cursor(first.begin(), first.end() - 1);
+        for(int v = 0; v < vertices; v++)
+            members[cursor[component[v]]++] = v;
+    }
+
+    // One edge per pair of adjacent components; a component with an inner edge contains a cycle
+    Graph dag(components);
+    std::vector<int> last_source(components, -1);
+    std::vector<std::vector<int>> cycles;
+    for(int c = 0; c < components; c++){
+        bool cyclic = false;
+        for(int i = first[c]; i < first[c + 1]; i++){
+            forEachNeighbor(members[i], [&](int v){
+                int d = component[v];
+                if(d == c)
+                    cyclic = true;
+                else if(last_source[d] != c){
+                    last_source[d] = c;
+                    dag.addEdge(c, d);
+                }
+            });
         }
+        if(cyclic)
+            cycles.emplace_back(members.begin() + first[c], members.begin() + first[c + 1]);
     }
+
+    std::vector<int> component_order, order;
+    dag.topologicalOrder(component_order);
+    order.reserve(vertices);
+    for(int c : component_order)
+        order.insert(order.end(), members.begin() + first[c], members.begin() + first[c + 1]);
+    return Condensation{components, std::move(component), std::move(component_order), std::move(order),
+                        std::move(cycles), std::move(dag)};
+}
+
+class IncrementalTopologicalOrder{
+    private:
+        Graph& graph;                           // Graph kept in sync with every accepted edge
+        std::vector<std::vector<int>> out_edges;  // Successors of each vertex
+        std::vector<std::vector<int>> in_edges;   // Predecessors of each vertex
+        std::vector<int> ord;                   // Position of each vertex in the topological order
+        std::vector<int> vertex_at;             // Vertex stored at each position
+        std::vector<bool> visited;              // Marks the vertices of the affected region
+        std::vector<int> forward_region;        // Vertices reachable from v inside the affected region
+        std::vector<int> backward_region;       // Vertices that reach u inside the affected region
+        std::vector<int> dfs_stack;             // Explicit stack shared by both searches
+        std::vector<int> positions;             // Positions freed by the affected region
+
+        bool collectForward(int, int, int);     // Forward search from v bounded by ord[u]; false on a cycle
+        void collectBackward(int, int);         // Backward search from u bounded by ord[v]
+        void reorder();                         // Moves the backward region before the forward region
+
+    public:
+        IncrementalTopologicalOrder(Graph&);
+        bool addEdge(int, int);                 // Inserts u -> v keeping the order valid
+        int position(int) const;                // Position of a vertex in the current order
+        const std::vector<int>& order() const;  // Vertices in topological order
+};
+
+IncrementalTopologicalOrder::IncrementalTopologicalOrder(Graph& graph) : graph(graph){
+    int vertices = graph.vertexCount();
+    graph.topologicalOrder(vertex_at);  // Also freezes the graph
+    ord.resize(vertices);
+    for(int i = 0; i < vertices; i++)
+        ord[vertex_at[i]] = i;
+
+    out_edges.resize(vertices);
+    in_edges.resize(vertices);
+    for(int u = 0; u < vertices; u++)
+        graph.forEachNeighbor(u, [&](int v){
+            if(ord[u] >= ord[v])
+                throw std::invalid_argument("Graph has a cycle");
+            out_edges[u].push_back(v);
+            in_edges[v].push_back(u);
+        });
+    visited.assign(vertices, false);
+}
+
+// Time complexity = O(1) if the order is already right, otherwise O(size of the affected region)
+bool IncrementalTopologicalOrder::addEdge(int u, int v){
+    if(u < 0 || u >= (int)ord.size() || v < 0 || v >= (int)ord.size())
+        throw std::out_of_range("Vertex doesn't exist");
+    if(u == v)
+        return false;                // A self-loop is a cycle
+    int lower_bound = ord[v];
+    int upper_bound = ord[u];
+    if(lower_bound < upper_bound){
+        // v comes before u: only vertices with positions in [ord[v], ord[u]] may have to move
+        if(!collectForward(v, u, upper_bound))
+            return false;
+        collectBackward(u, lower_bound);
+        reorder();
+    }
+    out_edges[u].push_back(v);
+    in_edges[v].push_back(u);
+    graph.addEdge(u, v);
+    return true;
+}
+
+bool IncrementalTopologicalOrder::collectForward(int v, int u, int upper_bound){
+    forward_region.clear();
+    dfs_stack.assign(1, v);
+    visited[v] = true;
+    while(!dfs_stack.empty()){
+        int w = dfs_stack.back();
+        dfs_stack.pop_back();
+        forward_region.push_back(w);
+        for(int x : out_edges[w]){
+            if(x == u){
+                // u is reachable from v, so u -> v would close a cycle
+                for(int y : forward_region)
+                    visited[y] = false;
+                for(int y : dfs_stack)
+                    visited[y] = false;
+                return false;
+            }
+            if(!visited[x] && ord[x] < upper_bound){
+                visited[x] = true;
+                dfs_stack.push_back(x);
+            }
+        }
+    }
+    return true;
+}
+
+void IncrementalTopologicalOrder::collectBackward(int u, int lower_bound){
+    backward_region.clear();
+    dfs_stack.assign(1, u);
+    visited[u] = true;
+    while(!dfs_stack.empty()){
+        int w = dfs_stack.back();
+        dfs_stack.pop_back();
+        backward_region.push_back(w);
+        for(int x : in_edges[w]){
+            if(!visited[x] && ord[x] > lower_bound){
+                visited[x] = true;
+                dfs_stack.push_back(x);
+            }
+        }
+    }
+}
+
+void IncrementalTopologicalOrder::reorder(){
+    auto byPosition = [&](int a, int b){ return ord[a] < ord[b]; };
+    std::sort(forward_region.begin(), forward_region.end(), byPosition);
+    std::sort(backward_region.begin(), backward_region.end(), byPosition);
+
+    // Reuse exactly the positions the two regions occupied: backward region first, then forward region
+    positions.clear();
+    for(int w : backward_region)
+        positions.push_back(ord[w]);
+    for(int w : forward_region)
+        positions.push_back(ord[w]);
+    std::inplace_merge(positions.begin(), positions.begin() + backward_region.size(), positions.end());
+
+    std::size_t i = 0;
+    for(int w : backward_region){
+        visited[w] = false;
+        ord[w] = positions[i++];
+        vertex_at[ord[w]] = w;
+    }
+    for(int w : forward_region){
+        visited[w] = false;
+        ord[w] = positions[i++];
+        vertex_at[ord[w]] = w;
+    }
+}
+
+// Time complexity = O(1)
+int IncrementalTopologicalOrder::position(int v) const{
+    return ord[v];
 }
 
-int main(){
-    Graph g;
+// Time complexity = O(1)
+const std::vector<int>& IncrementalTopologicalOrder::order() const{
+    return vertex_at;
+}
+
+struct ExecutionReport {
+    int criticalPathLength;          // Vertices on the longest dependency chain
+    double criticalPathSeconds;      // Measured duration of the slowest dependency chain
+    double totalWorkSeconds;         // Sum of the durations of every task
+    double wallSeconds;              // Elapsed time of the whole run
+    double parallelism;              // Achieved parallelism: totalWorkSeconds / wallSeconds
+};
+
+class DagExecutor{
+    private:
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<int> ready;   // Owner pushes and pops at the back, thieves take from the front
+        };
+
+        Graph& graph;
+        std::vector<std::function<void()>> tasks;  // Work attached to each vertex
+        std::vector<int> order;                    // Topological order, used to measure the critical path
+        std::vector<int> level;                    // Depth of each vertex in the DAG
+        std::vector<int> predecessors;             // In-degree of each vertex
+
+    public:
+        DagExecutor(Graph&);
+        void setTask(int, std::function<void()>);  // Attaches the work of a vertex
+        ExecutionReport run(int = 0);              // Runs every task respecting the dependencies
+};
+
+DagExecutor::DagExecutor(Graph& graph) : graph(graph){
+    if(!graph.parallelTopologicalSort(order, level))
+        throw std::invalid_argument("Graph has a cycle");
+    int vertices = graph.vertexCount();
+    tasks.resize(vertices);
+    predecessors.assign(vertices, 0);
+    for(int u = 0; u < vertices; u++)
+        graph.forEachNeighbor(u, [&](int v){ predecessors[v]++; });
+}
+
+void DagExecutor::setTask(int v, std::function<void()> task){
+    if(v < 0 || v >= (int)tasks.size())
+        throw std::out_of_range("Vertex doesn't exist");
+    tasks[v] = std::move(task);
+}
+
+// Time complexity = O((V + E) / threads) plus the tasks themselves
+ExecutionReport DagExecutor::run(int threads){
+    typedef std::chrono::steady_clock Clock;
+    if(threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    int vertices = graph.vertexCount();
+
+    std::vector<std::atomic<int>> unfinished(vertices);  // Predecessors of each vertex still running
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    for(int t = 0; t < threads; t++)
+        queues.emplace_back(new WorkQueue);
+    std::atomic<int> ready_count(0);                   // Tasks sitting in the deques, updated under their locks
+    for(int v = 0, t = 0; v < vertices; v++){
+        unfinished[v].store(predecessors[v], std::memory_order_relaxed);
+        if(predecessors[v] == 0){
+            queues[t++ % threads]->ready.push_back(v);  // Spread the sources over the workers
+            ready_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    std::mutex sleep_mutex;                             // Idle workers wait on wake until there is work
+    std::condition_variable wake;
+
+    std::atomic<int> pending(vertices);                 // Tasks that haven't finished yet
+    std::vector<double> duration(vertices, 0.0);
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    std::atomic<bool> failed(false);
+
+    auto take = [&](int t, int& v){
+        {
+            std::lock_guard<std::mutex> lock(queues[t]->mutex);
+            if(!queues[t]->ready.empty()){
+                v = queues[t]->ready.back();  // Most recently released task: its inputs are still hot
+                queues[t]->ready.pop_back();
+                ready_count.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        for(int i = 1; i < threads; i++){
+            WorkQueue& victim = *queues[(t + i) % threads];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if(!victim.ready.empty()){
+                v = victim.ready.front();     // Oldest task of the victim
+                victim.ready.pop_front();
+                ready_count.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto worker = [&](int t){
+        int v;
+        while(pending.load(std::memory_order_acquire) > 0){
+            // Steal only while some deque holds a task; otherwise sleep until one is released
+            if(ready_count.load(std::memory_order_acquire) == 0 || !take(t, v)){
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                wake.wait(lock, [&]{
+                    return ready_count.load(std::memory_order_acquire) > 0 ||
+                           pending.load(std::memory_order_acquire) == 0;
+                });
+                continue;
+            }
+            Clock::time_point start = Clock::now();
+            if(tasks[v] && !failed.load(std::memory_order_relaxed)){
+                try{
+                    tasks[v]();
+                }
+                catch(...){
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if(!error)
+                        error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);  // Remaining tasks are skipped
+                }
+            }
+            duration[v] = std::chrono::duration<double>(Clock::now() - start).count();
+
+            // acq_rel makes the work of every predecessor visible to the thread that runs a successor
+            graph.forEachNeighbor(v, [&](int w){
+                if(unfinished[w].fetch_sub(1, std::memory_order_acq_rel) == 1){
+                    {
+                        std::lock_guard<std::mutex> lock(queues[t]->mutex);
+                        queues[t]->ready.push_back(w);
+                        ready_count.fetch_add(1, std::memory_order_release);
+                    }
+                    { std::lock_guard<std::mutex> lock(sleep_mutex); }  // A waiter can't miss the notify
+                    wake.notify_one();
+                }
+            });
+            if(pending.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                { std::lock_guard<std::mutex> lock(sleep_mutex); }
+                wake.notify_all();            // Everything ran: release the sleeping workers
+            }
+        }
+    };
+
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> pool;
+    for(int t = 1; t < threads; t++)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for(std::thread& thread : pool)
+        thread.join();
+    double wall = std::chrono::duration<double>(Clock::now() - start).count();
+    if(error)
+        std::rethrow_exception(error);
+
+    // Longest chain weighted by the measured durations, in topological order
+    ExecutionReport report = {0, 0.0, 0.0, wall, 0.0};
+    std::vector<double> finish(vertices, 0.0);
+    for(int u : order){
+        finish[u] += duration[u];
+        report.totalWorkSeconds += duration[u];
+        report.criticalPathSeconds = std::max(report.criticalPathSeconds, finish[u]);
+        report.criticalPathLength = std::max(report.criticalPathLength, level[u] + 1);
+        graph.forEachNeighbor(u, [&](int v){ finish[v] = std::max(finish[v], finish[u]); });
+    }
+    report.parallelism = wall > 0 ? report.totalWorkSeconds / wall : 0.0;
+    return report;
+}
+
+const std::int64_t DEFAULT_CLOSURE_BYTES = std::int64_t(1) << 30;  // Largest closure kept as bitsets
+
+class ReachabilityIndex{
+    private:
+        static const int LABELINGS = 2;
+        Graph& graph;
+        int vertices;
+        std::int64_t words;                   // 64-bit words in each closure row
+        std::vector<std::uint64_t> closure;   // Row u has bit v set when v is reachable from u (small graphs)
+        std::vector<int> level;               // Longest path from a source; a path u -> v needs level[u] < level[v]
+        std::vector<int> low;                 // Labeling k of v: [low[k * V + v], rank[k * V + v]]
+        std::vector<int> rank;
+        std::vector<int> visit_mark;          // Pruned DFS of the labeled mode: epoch of the last visit
+        std::vector<int> dfs_stack;
+        int epoch;
+
+        bool contains(int, int) const;        // True if every interval of u contains the one of v
+        bool labeledSearch(int, int);         // DFS from u pruned by the labels
+
+    public:
+        ReachabilityIndex(Graph&, std::int64_t = DEFAULT_CLOSURE_BYTES);
+        bool reaches(int, int);               // True if v is reachable from u
+        bool usesClosure() const;             // True if queries are answered by the bitset closure
+};
+
+#if defined(__AVX2__) || defined(GRAPH_SIMD_DISPATCH)
+// AVX2 part of orRow: ORs whole 4-word groups and returns how many words it handled
+AVX2_TARGET std::int64_t orRowAvx2(std::uint64_t* destination, const std::uint64_t* source, std::int64_t words){
+    std::int64_t i = 0;
+    for(; i + 4 <= words; i += 4){
+        __m256i a = _mm256_loadu_si256((const __m256i*)(destination + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(source + i));
+        _mm256_storeu_si256((__m256i*)(destination + i), _mm256_or_si256(a, b));
+    }
+    return i;
+}
+#endif
+
+#ifdef GRAPH_SIMD_DISPATCH
+// True if the running CPU supports AVX2; computed once
+bool cpuHasAvx2(){
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+#endif
+
+// Word-wide OR of a closure row into another one
+void orRow(std::uint64_t* destination, const std::uint64_t* source, std::int64_t words){
+    std::int64_t i = 0;
+#if defined(GRAPH_SIMD_DISPATCH)
+    if(cpuHasAvx2())
+        i = orRowAvx2(destination, source, words);
+#elif defined(__AVX2__)
+    i = orRowAvx2(destination, source, words);
+#endif
+    for(; i < words; i++)            // Remaining words (or every word without AVX2; compilers vectorize this)
+        destination[i] |= source[i];
+}
+
+// Time complexity = O(V * V / 64 + E * V / 64) with the closure, O(V + E) with the labels
+ReachabilityIndex::ReachabilityIndex(Graph& graph, std::int64_t closure_bytes) : graph(graph){
+    std::vector<int> kahn_order, dfs_order;
+    if(!graph.parallelTopologicalSort(kahn_order, level))
+        throw std::invalid_argument("Graph has a cycle");
+    vertices = graph.vertexCount();
+    words = (vertices + 63) / 64;
+    epoch = 0;
+
+    if(words * vertices * (std::int64_t)sizeof(std::uint64_t) <= closure_bytes){
+        // Reverse topological order: every successor's row is complete before it is merged
+        closure.assign(words * vertices, 0);
+        for(int i = vertices - 1; i >= 0; i--){
+            int u = kahn_order[i];
+            std::uint64_t* row = &closure[u * words];
+            graph.forEachNeighbor(u, [&](int v){
+                orRow(row, &closure[v * words], words);
+                row[v / 64] |= std::uint64_t(1) << (v % 64);
+            });
+        }
+        return;
+    }
+
+    // Both orders are topological, so ranks taken from the back decrease along every edge
+    graph.topologicalOrder(dfs_order);
+    const std::vector<int>* orders[LABELINGS] = {&dfs_order, &kahn_order};
+    low.resize((std::int64_t)LABELINGS * vertices);
+    rank.resize((std::int64_t)LABELINGS * vertices);
+    for(int k = 0; k < LABELINGS; k++){
+        int* low_k = &low[(std::int64_t)k * vertices];
+        int* rank_k = &rank[(std::int64_t)k * vertices];
+        for(int i = vertices - 1; i >= 0; i--){
+            int u = (*orders[k])[i];
+            rank_k[u] = vertices - 1 - i;
+            low_k[u] = rank_k[u];
+            graph.forEachNeighbor(u, [&](int v){ low_k[u] = std::min(low_k[u], low_k[v]); });
+        }
+    }
+    visit_mark.assign(vertices, 0);
+}
+
+// Time complexity = O(1)
+bool ReachabilityIndex::contains(int u, int v) const{
+    for(int k = 0; k < LABELINGS; k++){
+        std::int64_t base = (std::int64_t)k * vertices;
+        if(low[base + v] < low[base + u] || rank[base + v] > rank[base + u])
+            return false;
+    }
+    return true;
+}
+
+// Time complexity = O(1) with the closure; O(1) for most negative queries with the labels
+bool ReachabilityIndex::reaches(int u, int v){
+    if(u < 0 || u >= vertices || v < 0 || v >= vertices)
+        throw std::out_of_range("Vertex doesn't exist");
+    if(u == v)
+        return true;
+    if(!closure.empty())
+        return (closure[u * words + v / 64] >> (v % 64)) & 1;
+    if(level[u] >= level[v] || !contains(u, v))
+        return false;
+    return labeledSearch(u, v);
+}
+
+bool ReachabilityIndex::labeledSearch(int u, int v){
+    if(++epoch == 0){                // Epoch wrapped around: forget every old mark
+        std::fill(visit_mark.begin(), visit_mark.end(), 0);
+        epoch = 1;
+    }
+    dfs_stack.assign(1, u);
+    visit_mark[u] = epoch;
+    bool found = false;
+    while(!dfs_stack.empty() && !found){
+        int w = dfs_stack.back();
+        dfs_stack.pop_back();
+        graph.forEachNeighbor(w, [&](int x){
+            if(x == v)
+                found = true;
+            else if(visit_mark[x] != epoch && level[x] < level[v] && contains(x, v)){
+                visit_mark[x] = epoch;   // Only vertices whose labels allow reaching v are explored
+                dfs_stack.push_back(x);
+            }
+        });
+    }
+    return found;
+}
+
+// Time complexity = O(1)
+bool ReachabilityIndex::usesClosure() const{
+    return !closure.empty();
+}
+
+int main(int argc, char* argv[]){
+    try{
+        if(argc == 4 && std::string(argv[1]) == "--convert"){
+            // graph --convert edges.txt graph.bin
+            Graph::convertEdgeList(argv[2], argv[3]);
+            return 0;
+        }
+        if(argc == 4 && std::string(argv[1]) == "--ingest"){
+            // graph --ingest dependencies.txt graph.bin
+            Graph::ingestDependencies(argv[2]).saveBinary(argv[3]);
+            return 0;
+        }
+        if(argc == 3 && std::string(argv[1]) == "--sort"){
+            // graph --sort graph.bin: prints one vertex per line in topological order, cycles go to stderr
+            Graph graph(argv[2]);
+            graph.validate();        // The file comes from outside: check it once before traversing it
+            Condensation condensation = graph.condense(true);
+            for(const std::vector<int>& cycle : condensation.cycles){
+                std::cerr << "Cycle:";
+                for(int v : cycle){
+                    if(graph.hasNames())
+                        std::cerr << " " << graph.vertexName(v);
+                    else
+                        std::cerr << " " << v;
+                }
+                std::cerr << "\n";
+            }
+            for(int v : condensation.order){
+                if(graph.hasNames())
+                    std::cout << graph.vertexName(v) << "\n";
+                else
+                    std::cout << v << "\n";
+            }
+            return 0;
+        }
+    }
+    catch(const std::exception& error){  // Bad input files end with a message, not an abort
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    Graph g(9);
+    g.setVertexNames({"undershorts", "socks", "shoes", "pants", "watch", "belt", "shirt", "tie", "jacket"});
     // Add directed edges based on dependency constraints
 
     g.addEdge(0, 3); // undershorts -> pants
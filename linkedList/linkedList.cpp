@@ -1,4 +1,98 @@
 #include <iostream>
+#include <random>
+#include <cstdio>
+#include <climits>
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+const std::size_t POOL_SLAB_SIZE = 4096;  // Objects carved from each slab
+
+// Free-list allocator for list nodes: objects come from large slabs, freed ones are reused first,
+// and clear() gives every slab back at once instead of deleting object by object
+template <typename T>
+class Pool{
+    static_assert(std::is_trivially_destructible<T>::value, "clear() skips destructors");
+    private:
+        union Slot{
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+        std::vector<Slot*> slabs;
+        Slot* freeList;              // Released slots, most recent first
+        std::size_t used;            // Slots handed out from the newest slab
+
+    public:
+        Pool();
+        ~Pool();
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+        template <typename... Args>
+        T* create(Args&&...);
+        void destroy(T*);
+        void clear();
+};
+
+template <typename T>
+Pool<T>::Pool(){
+    freeList = nullptr;
+    used = POOL_SLAB_SIZE;
+}
+
+template <typename T>
+Pool<T>::~Pool(){
+    clear();
+}
+
+// Time Complexity O(1) amortized
+template <typename T>
+template <typename... Args>
+T* Pool<T>::create(Args&&... args){
+    Slot* slot = freeList;
+    if(slot != nullptr)
+        freeList = slot->next;
+    else{
+        if(used == POOL_SLAB_SIZE){
+            slabs.push_back(new Slot[POOL_SLAB_SIZE]);
+            used = 0;
+        }
+        slot = &slabs.back()[used++];
+    }
+    return new (slot->storage) T(std::forward<Args>(args)...);
+}
+
+// Time Complexity O(1)
+template <typename T>
+void Pool<T>::destroy(T* object){
+    Slot* slot = reinterpret_cast<Slot*>(object);
+    slot->next = freeList;
+    freeList = slot;
+}
+
+// Time Complexity O(slabs)
+template <typename T>
+void Pool<T>::clear(){
+    for(Slot* slab : slabs)
+        delete[] slab;
+    slabs.clear();
+    freeList = nullptr;
+    used = POOL_SLAB_SIZE;
+}
 
 class Node{
     public:
@@ -12,83 +106,271 @@ Node::Node(int data){
     next = nullptr;
 }
 
+// Express lane of the sorted list: a tower level above the nodes, skipping `span` nodes to the right
+class IndexNode{
+    public:
+        Node* node;
+        IndexNode* right;
+        IndexNode* down;
+        int span;
+        IndexNode(Node* = nullptr, IndexNode* = nullptr);
+};
+
+IndexNode::IndexNode(Node* node, IndexNode* down){
+    this->node = node;
+    this->down = down;
+    right = nullptr;
+    span = 0;
+}
+
+const int MAX_INDEX_LEVEL = 16;      // Each level keeps 1/4 of the one below: enough for 4^16 elements
+
+template <typename List>
+class ListMenu;
+
 class LinkedList{
     private:
         Node* first;
         Node* last;
         bool isSorted;
+        bool isIndexed;                              // Keeps the towers (always true when sorted)
+        int size;
+        int levels;                                  // Index levels in use above the nodes
+        IndexNode heads[MAX_INDEX_LEVEL + 1];        // Sentinel towers at position -1 (heads[0] unused)
+        std::minstd_rand random;
+        Pool<Node> nodes;
+        Pool<IndexNode> towers;
 
+        int randomLevel();
+        Node* findPredecessors(int, bool, IndexNode**, int*, int&);
+        Node* findPosition(int, IndexNode**, int*);
+        void linkIndexed(Node*, Node*, int, IndexNode**, int*);
+        void unlinkIndexed(Node*, Node*, IndexNode**);
         void insertFirst(int);
         void insertLast(int);
         void insert(int, int = 0);
-        void insertSorted(int, Node*&, Node*&);
+        void insertSorted(int);
         void insertAtPosition(int, Node*, Node*, int);
+        int indexOf(int);
+        int get(int);
+        bool erase(int);
+        bool eraseAt(int);
+        bool eraseFirst();
         void search(int);
         void removeFirst();
         void remove(int);
+        void clear();
+        void rebuildIndex();
+        void appendNodes(const int*, std::size_t);
+        void insertBatch(std::vector<int>);
+        bool loadFromFile(const std::string&, bool);
+        Node* cutRun(Node*);
+        Node* mergeRuns(Node*, Node*, Node*&);
+        void sort();
         void printList();
-        void interfaceSortedList();
-        void interfaceList();
+        void interfaceBatch();
+        void interfaceLoad();
     public:
-        LinkedList(bool);
+        LinkedList(bool, bool = false);
+        friend void benchmarkLists();
+        friend class ListMenu<LinkedList>;
         void interface();        
 };
 
-LinkedList::LinkedList(bool isSorted){
+LinkedList::LinkedList(bool isSorted, bool isIndexed){
     first = nullptr;
     last = nullptr;
     this->isSorted = isSorted;
+    this->isIndexed = isSorted || isIndexed;
+    size = 0;
+    levels = 0;
+    for(int level = 2; level <= MAX_INDEX_LEVEL; level++)
+        heads[level].down = &heads[level - 1];
 }
 
-// Time Complexity O(1)
+// Height of a new tower: each level is kept with probability 1/4
+int LinkedList::randomLevel(){
+    int level = 0;
+    while(level < MAX_INDEX_LEVEL && (random() & 3) == 0)
+        level++;
+    return level;
+}
+
+// Walks the index down to the last node whose data is < data (<= data if inclusive), or nullptr if
+// there is none. Fills, for every index level, the last tower visited and its position.
+// Expected Time Complexity O(log n)
+Node* LinkedList::findPredecessors(int data, bool inclusive, IndexNode** update, int* rank, int& position){
+    IndexNode* aux = &heads[levels];
+    position = -1;
+    for(int level = levels; level >= 1; level--){
+        while(aux->right != nullptr &&
+              (aux->right->node->data < data || (inclusive && aux->right->node->data == data))){
+            position += aux->span;
+            aux = aux->right;
+        }
+        update[level] = aux;
+        rank[level] = position;
+        if(level > 1)
+            aux = aux->down;
+    }
+    Node* prev = levels > 0 ? aux->node : nullptr;
+    Node* next = prev != nullptr ? prev->next : first;
+    while(next != nullptr && (next->data < data || (inclusive && next->data == data))){
+        prev = next;
+        next = next->next;
+        position++;
+    }
+    return prev;
+}
+
+// Walks the index down to the node before position (nullptr for position 0), filling update and rank
+// like findPredecessors
+// Expected Time Complexity O(log n)
+Node* LinkedList::findPosition(int position, IndexNode** update, int* rank){
+    IndexNode* aux = &heads[levels];
+    int current = -1;
+    for(int level = levels; level >= 1; level--){
+        while(aux->right != nullptr && current + aux->span < position){
+            current += aux->span;
+            aux = aux->right;
+        }
+        update[level] = aux;
+        rank[level] = current;
+        if(level > 1)
+            aux = aux->down;
+    }
+    Node* prev = levels > 0 ? aux->node : nullptr;
+    for(; current < position - 1; current++)
+        prev = prev != nullptr ? prev->next : first;
+    return prev;
+}
+
+// Links newNode after prev, at position, and raises its tower over the jumps recorded in update
+// Expected Time Complexity O(log n)
+void LinkedList::linkIndexed(Node* newNode, Node* prev, int position, IndexNode** update, int* rank){
+    newNode->next = prev != nullptr ? prev->next : first;
+    if(prev == nullptr)
+        first = newNode;
+    else
+        prev->next = newNode;
+    if(newNode->next == nullptr)
+        last = newNode;
+
+    int height = randomLevel();
+    for(; levels < height; levels++){  // New levels start empty, spanning the whole list
+        heads[levels + 1].span = size + 1;
+        update[levels + 1] = &heads[levels + 1];
+        rank[levels + 1] = -1;
+    }
+    IndexNode* below = nullptr;
+    for(int level = 1; level <= levels; level++){
+        if(level <= height){
+            IndexNode* tower = towers.create(newNode, below);
+            tower->right = update[level]->right;
+            update[level]->right = tower;
+            tower->span = update[level]->span - (position - rank[level]) + 1;
+            update[level]->span = position - rank[level];
+            below = tower;
+        }
+        else
+            update[level]->span++;   // One more node under this jump
+    }
+    size++;
+}
+
+// Removes node (preceded by prev) from the nodes and from the towers recorded in update
+// Time Complexity O(log n)
+void LinkedList::unlinkIndexed(Node* node, Node* prev, IndexNode** update){
+    for(int level = 1; level <= levels; level++){
+        IndexNode* tower = update[level]->right;
+        if(tower != nullptr && tower->node == node){
+            update[level]->span += tower->span - 1;
+            update[level]->right = tower->right;
+            towers.destroy(tower);
+        }
+        else
+            update[level]->span--;
+    }
+    while(levels > 0 && heads[levels].right == nullptr)
+        levels--;
+    if(prev == nullptr)
+        first = node->next;
+    else
+        prev->next = node->next;
+    if(node == last)
+        last = prev;
+    nodes.destroy(node);
+    size--;
+}
+
+// Time Complexity O(1), expected O(log n) when indexed
 void LinkedList::insertFirst(int data){
-    Node* newNode = new Node(data);
+    if(isIndexed){
+        insertAtPosition(data, first, nullptr, 0);
+        return;
+    }
+    Node* newNode = nodes.create(data);
     newNode->next = first;
     if(first == nullptr)
         last = newNode;
     first = newNode;
+    size++;
 }
 
-// Time Complexity O(1)
+// Time Complexity O(1), expected O(log n) when indexed
 void LinkedList::insertLast(int data){
-    Node* newNode = new Node(data);
+    if(isIndexed){
+        insertAtPosition(data, first, nullptr, size);
+        return;
+    }
+    Node* newNode = nodes.create(data);
     if(last == nullptr)
         first = newNode;
     else{
         last->next = newNode;
     }
     last = newNode;
+    size++;
 }
 
 // Time Complexity O(1)
 void LinkedList::insert(int data, int position){
-    Node* aux = first;
-    Node* prev = nullptr;
     if(isSorted){
-        insertSorted(data, aux, prev);
+        insertSorted(data);
     }
     else
-        insertAtPosition(data, aux, prev, position);
+        insertAtPosition(data, first, nullptr, position);
 }
 
-// Time Complexity O(n)
-void LinkedList::insertSorted(int data, Node* &aux, Node* &prev){
-    while(aux != nullptr && aux->data <= data){
-        prev = aux;
-        aux = aux->next;
-    }
-    if(prev == nullptr){
-        this->insertFirst(data);
-    }
-    else{
-        Node* newNode = new Node(data);
-        prev->next = newNode;
-        newNode->next = aux;
-    }
+// Equal data is kept in insertion order: the new node goes after its duplicates
+// Expected Time Complexity O(log n)
+void LinkedList::insertSorted(int data){
+    IndexNode* update[MAX_INDEX_LEVEL + 1];
+    int rank[MAX_INDEX_LEVEL + 1];
+    int position;
+    Node* prev = findPredecessors(data, true, update, rank, position);
+    linkIndexed(nodes.create(data), prev, position + 1, update, rank);
 }
 
-// Time Complexity O(n)
+// Time Complexity O(n), expected O(log n) when indexed
 void LinkedList::insertAtPosition(int data, Node* aux, Node* prev, int position){
+    if(isIndexed){
+        if(position < 0){            // Before any index work: a negative rank would corrupt the spans
+            std::cout << "List doesn't have " << position <<
+                " elements. Inserting at the position: 0" << std::endl;
+            position = 0;
+        }
+        else if(position > size){
+            std::cout << "List doesn't have " << position <<
+                " elements. Inserting at the position: " << size << std::endl;
+            position = size;
+        }
+        IndexNode* update[MAX_INDEX_LEVEL + 1];
+        int rank[MAX_INDEX_LEVEL + 1];
+        prev = findPosition(position, update, rank);
+        linkIndexed(nodes.create(data), prev, position, update, rank);
+        return;
+    }
     int positionAux = 0;
     while(aux != nullptr && positionAux < position){
         positionAux++;
@@ -103,66 +385,382 @@ void LinkedList::insertAtPosition(int data, Node* aux, Node* prev, int position)
         this->insertFirst(data);
     }
     else{
-        Node* newNode = new Node(data);
+        Node* newNode = nodes.create(data);
         prev->next = newNode;
         newNode->next = aux;
         if(aux == nullptr)
             last = newNode;
+        size++;
     }
 }
 
-// Time Complexity O(n)
-void LinkedList::search(int data){
-    Node* aux = first;
+// Position of the first node holding data, or -1
+// Time Complexity O(n), expected O(log n) on a sorted list
+int LinkedList::indexOf(int data){
     int position = 0;
+    Node* aux = first;
+    if(isSorted){
+        IndexNode* update[MAX_INDEX_LEVEL + 1];
+        int rank[MAX_INDEX_LEVEL + 1];
+        Node* prev = findPredecessors(data, false, update, rank, position);
+        position++;
+        aux = prev != nullptr ? prev->next : first;
+        return aux != nullptr && aux->data == data ? position : -1;
+    }
     while(aux != nullptr && aux->data != data){
         aux = aux->next;
         position++;
     }
-    if(aux != nullptr)
+    return aux != nullptr ? position : -1;
+}
+
+// Data at position (which must be below size)
+// Time Complexity O(n), expected O(log n) when indexed
+int LinkedList::get(int position){
+    if(isIndexed){
+        IndexNode* update[MAX_INDEX_LEVEL + 1];
+        int rank[MAX_INDEX_LEVEL + 1];
+        Node* prev = findPosition(position, update, rank);
+        return prev != nullptr ? prev->next->data : first->data;
+    }
+    Node* aux = first;
+    for(int i = 0; i < position; i++)
+        aux = aux->next;
+    return aux->data;
+}
+
+// Removes the node at position; false if the list is shorter
+// Time Complexity O(n), expected O(log n) when indexed
+bool LinkedList::eraseAt(int position){
+    if(position < 0 || position >= size)
+        return false;
+    if(isIndexed){
+        IndexNode* update[MAX_INDEX_LEVEL + 1];
+        int rank[MAX_INDEX_LEVEL + 1];
+        Node* prev = findPosition(position, update, rank);
+        unlinkIndexed(prev != nullptr ? prev->next : first, prev, update);
+        return true;
+    }
+    Node* prev = nullptr;
+    Node* aux = first;
+    for(int i = 0; i < position; i++){
+        prev = aux;
+        aux = aux->next;
+    }
+    if(prev == nullptr)
+        first = aux->next;
+    else
+        prev->next = aux->next;
+    if(aux == last)
+        last = prev;
+    nodes.destroy(aux);
+    size--;
+    return true;
+}
+
+// Removes the first node holding data; false if there is none
+// Time Complexity O(n), expected O(log n) on a sorted list
+bool LinkedList::erase(int data){
+    Node* prev = nullptr;
+    Node* aux = first;
+    if(isSorted){
+        IndexNode* update[MAX_INDEX_LEVEL + 1];
+        int rank[MAX_INDEX_LEVEL + 1];
+        int position;
+        prev = findPredecessors(data, false, update, rank, position);
+        aux = prev != nullptr ? prev->next : first;
+        if(aux == nullptr || aux->data != data)
+            return false;
+        unlinkIndexed(aux, prev, update);
+        return true;
+    }
+    if(isIndexed){
+        int position = indexOf(data);
+        return position != -1 && eraseAt(position);
+    }
+    while(aux != nullptr && aux->data != data){
+        prev = aux;
+        aux = aux->next;
+    }
+    if(aux == nullptr)
+        return false;
+    if(aux == first){
+        first = first->next;
+        if(first == nullptr)
+            last = nullptr;
+    }
+    else{
+        prev->next = aux->next;
+        if(aux == last)
+            last = prev;
+    }
+    nodes.destroy(aux);
+    size--;
+    return true;
+}
+
+// Time Complexity O(1), expected O(log n) when indexed
+bool LinkedList::eraseFirst(){
+    if(first == nullptr)
+        return false;
+    if(isIndexed){
+        IndexNode* update[MAX_INDEX_LEVEL + 1];
+        for(int level = 1; level <= levels; level++)
+            update[level] = &heads[level];  // The first node's towers hang right off the heads
+        unlinkIndexed(first, nullptr, update);
+        return true;
+    }
+    Node* aux = first;
+    first = first->next;
+    if(first == nullptr)
+        last = first;
+    nodes.destroy(aux);
+    size--;
+    return true;
+}
+
+void LinkedList::search(int data){
+    int position = indexOf(data);
+    if(position != -1)
         std::cout << "Data was found at the position " << position << "\n";
     else
         std::cout << "This Data doesn't exist\n";
 }
 
-// Time Complexity O(1)
 void LinkedList::removeFirst(){
-    if(first != nullptr){
-        Node* aux = first;
-        first = first->next;
-        if(first == nullptr)
-            last = first;
-        delete aux;
+    if(eraseFirst())
         std::cout << "Successfully excluded\n";
-    }
     else
         std::cout << "Data doesn't exists\n";
 }
 
-// Time Complexity O(n)
 void LinkedList::remove(int data){
+    if(erase(data))
+        std::cout << "Successfully excluded\n";
+    else
+        std::cout << "Data doesn't exists\n";
+}
+
+// Time Complexity O(slabs)
+void LinkedList::clear(){
+    nodes.clear();
+    towers.clear();
+    first = nullptr;
+    last = nullptr;
+    size = 0;
+    levels = 0;
+    for(int level = 1; level <= MAX_INDEX_LEVEL; level++){
+        heads[level].right = nullptr;
+        heads[level].span = 0;
+    }
+}
+
+// Throws the towers away and raises new ones over the current nodes in a single walk
+// Time Complexity O(n)
+void LinkedList::rebuildIndex(){
+    towers.clear();
+    IndexNode* tails[MAX_INDEX_LEVEL + 1];     // Last tower of each level and its position
+    int tailPosition[MAX_INDEX_LEVEL + 1];
+    levels = 0;
+    for(int level = 1; level <= MAX_INDEX_LEVEL; level++){
+        heads[level].right = nullptr;
+        tails[level] = &heads[level];
+        tailPosition[level] = -1;
+    }
+    int position = 0;
+    for(Node* aux = first; aux != nullptr; aux = aux->next, position++){
+        int height = randomLevel();
+        IndexNode* below = nullptr;
+        for(int level = 1; level <= height; level++){
+            IndexNode* tower = towers.create(aux, below);
+            tails[level]->right = tower;
+            tails[level]->span = position - tailPosition[level];
+            tails[level] = tower;
+            tailPosition[level] = position;
+            below = tower;
+        }
+        levels = std::max(levels, height);
+    }
+    for(int level = 1; level <= MAX_INDEX_LEVEL; level++)
+        tails[level]->span = size - tailPosition[level];  // Last jump runs to the end of the list
+}
+
+// Time Complexity O(count)
+void LinkedList::appendNodes(const int* values, std::size_t count){
+    for(std::size_t i = 0; i < count; i++){
+        Node* newNode = nodes.create(values[i]);
+        if(last == nullptr)
+            first = newNode;
+        else
+            last->next = newNode;
+        last = newNode;
+    }
+    size += (int)count;
+}
+
+// Sorts the batch and merges it into the list in one pass (appends it in order if the list is unsorted)
+// Time Complexity O(n + k log k)
+void LinkedList::insertBatch(std::vector<int> values){
+    if(!isSorted){
+        appendNodes(values.data(), values.size());
+        if(isIndexed)
+            rebuildIndex();
+        return;
+    }
+    if(values.size() * 32 < (std::size_t)size){
+        for(int value : values)      // A few values: the index beats touching every node
+            insertSorted(value);
+        return;
+    }
+    std::sort(values.begin(), values.end());
     Node* prev = nullptr;
     Node* aux = first;
-    while(aux != nullptr && aux->data != data){
-        prev = aux;
-        aux = aux->next;
+    for(int value : values){
+        while(aux != nullptr && aux->data <= value){  // Batch values go after equal ones already there
+            prev = aux;
+            aux = aux->next;
+        }
+        Node* newNode = nodes.create(value);
+        newNode->next = aux;
+        if(prev == nullptr)
+            first = newNode;
+        else
+            prev->next = newNode;
+        prev = newNode;
     }
-    if(aux != nullptr){
-        if(aux == first){
-            first = first->next;
-            if(first == nullptr)
-                last = nullptr;
+    if(aux == nullptr && prev != nullptr)
+        last = prev;
+    size += (int)values.size();
+    rebuildIndex();
+}
+
+// Detaches the non-decreasing run that starts at start and returns the node after it
+// Time Complexity O(run length)
+Node* LinkedList::cutRun(Node* start){
+    while(start->next != nullptr && start->data <= start->next->data)
+        start = start->next;
+    Node* rest = start->next;
+    start->next = nullptr;
+    return rest;
+}
+
+// Merges two sorted runs by relinking them; left wins ties, so the sort is stable
+// Time Complexity O(length of both runs)
+Node* LinkedList::mergeRuns(Node* left, Node* right, Node*& tail){
+    Node head(0);
+    tail = &head;
+    while(left != nullptr && right != nullptr){
+        if(right->data < left->data){
+            tail->next = right;
+            right = right->next;
         }
         else{
-            prev->next = aux->next;
-            if(aux == last)
-                last = prev;
+            tail->next = left;
+            left = left->next;
         }
-        delete aux;
-        std::cout << "Successfully excluded\n";               
+        tail = tail->next;
     }
-    else
-        std::cout << "Data doesn't exists\n";
+    tail->next = left != nullptr ? left : right;
+    while(tail->next != nullptr)
+        tail = tail->next;
+    return head.next;
+}
+
+// Bottom-up natural merge sort: every pass merges neighbouring runs until one is left.
+// Only pointers move; afterwards the list stays in sorted mode.
+// Time Complexity O(n log r), r = runs in the list (O(n) if it is already sorted)
+void LinkedList::sort(){
+    int runs = 2;
+    while(first != nullptr && runs > 1){
+        Node* head = nullptr;
+        Node** link = &head;
+        Node* rest = first;
+        Node* tail = nullptr;
+        runs = 0;
+        while(rest != nullptr){
+            Node* left = rest;
+            rest = cutRun(left);
+            Node* right = rest;
+            if(right != nullptr)
+                rest = cutRun(right);
+            *link = mergeRuns(left, right, tail);
+            link = &tail->next;
+            runs++;
+        }
+        first = head;
+        last = tail;
+    }
+    isSorted = true;
+    isIndexed = true;
+    rebuildIndex();
+}
+
+// Reads every int of a file: raw native ints if binary, otherwise whitespace separated text.
+// Returns false if the file can't be read or holds anything else.
+bool readInts(const std::string& path, bool binary, std::vector<int>& values){
+    std::FILE* input = std::fopen(path.c_str(), binary ? "rb" : "r");
+    if(input == nullptr)
+        return false;
+    std::vector<char> buffer(1 << 20);
+    std::size_t length, pending = 0;
+    bool valid = true, inNumber = false, negative = false;
+    long long number = 0;
+    while(valid && (length = std::fread(buffer.data() + pending, 1, buffer.size() - pending, input)) > 0){
+        if(binary){
+            length += pending;
+            std::size_t count = length / sizeof(int);
+            std::size_t old = values.size();
+            values.resize(old + count);
+            std::copy(buffer.data(), buffer.data() + count * sizeof(int), (char*)(values.data() + old));
+            pending = length - count * sizeof(int);  // Int cut by the end of the block
+            std::copy(buffer.data() + count * sizeof(int), buffer.data() + length, buffer.data());
+            continue;
+        }
+        for(std::size_t i = 0; i < length && valid; i++){
+            char ch = buffer[i];
+            if(ch >= '0' && ch <= '9'){
+                number = number * 10 + (ch - '0');
+                valid = number <= (long long)INT_MAX + 1;
+                inNumber = true;
+            }
+            else if(ch == '-' && !inNumber && !negative)
+                negative = true;
+            else if(ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r'){
+                if(inNumber){
+                    valid = negative || number <= INT_MAX;
+                    values.push_back((int)(negative ? -number : number));
+                }
+                else
+                    valid = !negative;
+                inNumber = negative = false;
+                number = 0;
+            }
+            else
+                valid = false;
+        }
+    }
+    if(inNumber && valid){
+        valid = negative || number <= INT_MAX;
+        values.push_back((int)(negative ? -number : number));
+    }
+    valid = valid && !std::ferror(input) && pending == 0 && !(negative && !inNumber);
+    std::fclose(input);
+    return valid;
+}
+
+// Replaces the list with the ints of a file, building the nodes and the index directly
+// Time Complexity O(k log k) sorted, O(k) unsorted
+bool LinkedList::loadFromFile(const std::string& path, bool binary){
+    std::vector<int> values;
+    if(!readInts(path, binary, values))
+        return false;
+    if(isSorted)
+        std::sort(values.begin(), values.end());
+    clear();
+    appendNodes(values.data(), values.size());
+    if(isIndexed)
+        rebuildIndex();
+    return true;
 }
 
 // Time Complexity O(n)
@@ -175,46 +773,100 @@ void LinkedList::printList(){
     std::cout << "NULL" << std::endl;
 }
 
-void LinkedList::interface(){
+void LinkedList::interfaceBatch(){
+    int count;
+    std::cout << "How many integers do you want to insert? ";
+    std::cin >> count;
+    std::vector<int> values(std::max(count, 0));
+    std::cout << "Type them: ";
+    for(int& value : values)
+        std::cin >> value;
+    insertBatch(values);
+}
+
+void LinkedList::interfaceLoad(){
+    std::string path;
+    char binary;
+    std::cout << "Which file? ";
+    std::cin >> path;
+    std::cout << "Is it binary? (y/n) ";
+    std::cin >> binary;
+    if(loadFromFile(path, binary == 'y' || binary == 'Y'))
+        std::cout << "Loaded " << size << " elements\n";
+    else
+        std::cout << "Can't read a list of integers from " << path << "\n";
+}
+
+// Interactive menu shared by LinkedList and UnrolledLinkedList. Both lists get the common operations;
+// batch insert, file loading, sorting and positional access are only offered by LinkedList
+template <typename List>
+class ListMenu{
+    private:
+        static constexpr bool EXTENDED = std::is_same<List, LinkedList>::value;
+        static void sortedList(List&);
+        static void unorderedList(List&);
+    public:
+        static void run(List&);
+};
+
+template <typename List>
+void ListMenu<List>::run(List& list){
     system("cls");
-    if(isSorted)
-        interfaceSortedList();
+    if(list.isSorted)
+        sortedList(list);
     else
-        interfaceList();
+        unorderedList(list);
 }
 
-void LinkedList::interfaceSortedList(){
+template <typename List>
+void ListMenu<List>::sortedList(List& list){
     char option = 'y';
     int operation, data;
     while(option == 'y' || option == 'Y'){
         std::cout << "What operation?"
         << "\n1 - Insert\n2 - Remove\n3 - Remove first element"
-        << "\n4 - Search element\n5 - Print List\n";
+        << "\n4 - Search element\n5 - Print List\n6 - Clear list";
+        if constexpr(EXTENDED)
+            std::cout << "\n7 - Insert many\n8 - Load from file";
+        std::cout << "\n";
         std::cin >> operation;
         switch (operation)
         {
             case 1:
                 std::cout << "What integer do you want to insert? ";
                 std::cin >> data;
-                insert(data);
+                list.insert(data);
                 break;
             case 2:
                 std::cout << "What data do you want to remove? ";
                 std::cin >> data;
-                remove(data);
+                list.remove(data);
                 break;
             case 3:
-                removeFirst();
+                list.removeFirst();
                 break;
             case 4:
                 std::cout << "What data do you want to search? ";
                 std::cin >> data;
-                search(data);
+                list.search(data);
                 break;
             case 5:
-                printList();
+                list.printList();
+                break;
+            case 6:
+                list.clear();
                 break;
             default:
+                if constexpr(EXTENDED){
+                    if(operation == 7){
+                        list.interfaceBatch();
+                        break;
+                    }
+                    if(operation == 8){
+                        list.interfaceLoad();
+                        break;
+                    }
+                }
                 std::cout << "Invalid Case. Try another one\n";
         }
         std::cout << "Do you want to continue working with this list? (y/n)\n";
@@ -223,7 +875,8 @@ void LinkedList::interfaceSortedList(){
     }
 }
 
-void LinkedList::interfaceList(){
+template <typename List>
+void ListMenu<List>::unorderedList(List& list){
     char option = 'y';
     int operation, data, position;
     while(option == 'y' || option == 'Y'){
@@ -234,44 +887,90 @@ void LinkedList::interfaceList(){
             << "\n4 - Remove first element"
             << "\n5 - Remove any element"
             << "\n6 - Search element"
-            << "\n7 - Print list\n";
+            << "\n7 - Print list"
+            << "\n8 - Clear list";
+        if constexpr(EXTENDED)
+            std::cout << "\n9 - Insert many at last position"
+                << "\n10 - Load from file"
+                << "\n11 - Sort list"
+                << "\n12 - Get element at position"
+                << "\n13 - Remove element at position";
+        std::cout << "\n";
         std::cin >> operation;
         switch (operation)
         {
             case 1:
                 std::cout << "What integer do you want to insert? ";
                 std::cin >> data;
-                insertFirst(data);
+                list.insertFirst(data);
                 break;
             case 2:
                 std::cout << "What integer do you want to insert? ";
                 std::cin >> data;
-                insertLast(data);
+                list.insertLast(data);
                 break; 
             case 3:
                 std::cout << "What integer do you want to insert? ";
                 std::cin >> data;
                 std::cout << "In which position should it be inserted? ";
                 std::cin >> position;
-                insert(data,position);
+                list.insert(data,position);
                 break;
             case 4:
-                removeFirst();
+                list.removeFirst();
                 break;
             case 5:
                 std::cout << "What data do you want to remove? ";
                 std::cin >> data;
-                remove(data);
+                list.remove(data);
                 break;
             case 6:
                 std::cout << "What data do you want to search? ";
                 std::cin >> data;
-                search(data);
+                list.search(data);
                 break;
             case 7:
-                printList();
+                list.printList();
+                break;
+            case 8:
+                list.clear();
                 break;
             default:
+                if constexpr(EXTENDED){
+                    switch (operation)
+                    {
+                        case 9:
+                            list.interfaceBatch();
+                            break;
+                        case 10:
+                            list.interfaceLoad();
+                            break;
+                        case 11:
+                            list.sort();
+                            std::cout << "List sorted. From now on it stays ordered\n";
+                            sortedList(list);
+                            return;
+                        case 12:
+                            std::cout << "Which position? ";
+                            std::cin >> position;
+                            if(position >= 0 && position < list.size)
+                                std::cout << "Data at the position " << position << ": " << list.get(position) << "\n";
+                            else
+                                std::cout << "List doesn't have " << position + 1 << " elements\n";
+                            break;
+                        case 13:
+                            std::cout << "Which position? ";
+                            std::cin >> position;
+                            if(list.eraseAt(position))
+                                std::cout << "Successfully excluded\n";
+                            else
+                                std::cout << "Data doesn't exists\n";
+                            break;
+                        default:
+                            std::cout << "Invalid Case. Try another one";
+                    }
+                    break;
+                }
                 std::cout << "Invalid Case. Try another one";
         }
         std::cout << "Do you want to continue working with this list? (y/n)\n";
@@ -280,13 +979,655 @@ void LinkedList::interfaceList(){
     }
 }
 
-int main(){
-    int isSorted;
+void LinkedList::interface(){
+    ListMenu<LinkedList>::run(*this);
+}
+
+const int BLOCK_CAPACITY = 16;       // 16 ints fill one 64-byte cache line
+const int BLOCK_MIN = BLOCK_CAPACITY / 2;
+
+// Node of the unrolled list: a cache line of values, kept in order
+class Block{
+    public:
+        alignas(64) int values[BLOCK_CAPACITY];
+        int count;
+        Block* next;
+        Block();
+};
+
+Block::Block() : values{}{
+    count = 0;
+    next = nullptr;
+}
+
+// Index of the lowest set bit (mask must not be 0)
+int lowestBit(unsigned mask){
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Index of the first value equal to data inside the block, or -1
+// Time Complexity O(BLOCK_CAPACITY / SIMD width)
+int findInBlock(const Block* block, int data){
+    unsigned mask = 0;
+#if defined(__AVX2__)
+    __m256i key = _mm256_set1_epi32(data);
+    for(int i = 0; i < BLOCK_CAPACITY; i += 8){
+        __m256i hits = _mm256_cmpeq_epi32(_mm256_load_si256((const __m256i*)(block->values + i)), key);
+        mask |= (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(hits)) << i;
+    }
+#elif defined(__SSE2__)
+    __m128i key = _mm_set1_epi32(data);
+    for(int i = 0; i < BLOCK_CAPACITY; i += 4){
+        __m128i hits = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)(block->values + i)), key);
+        mask |= (unsigned)_mm_movemask_ps(_mm_castsi128_ps(hits)) << i;
+    }
+#else
+    for(int i = 0; i < BLOCK_CAPACITY; i++)
+        mask |= (unsigned)(block->values[i] == data) << i;
+#endif
+    mask &= (1u << block->count) - 1;  // Slots past count hold stale values
+    return mask != 0 ? lowestBit(mask) : -1;
+}
+
+class UnrolledLinkedList{
+    private:
+        Block* first;
+        Block* last;
+        bool isSorted;
+        int size;
+        Pool<Block> blocks;
+
+        void insertInBlock(Block*, int, int);
+        void eraseInBlock(Block*, Block*, int);
+        void insertFirst(int);
+        void insertLast(int);
+        void insert(int, int = 0);
+        void insertSorted(int);
+        void insertAtPosition(int, int);
+        int indexOf(int);
+        bool erase(int);
+        bool eraseFirst();
+        void search(int);
+        void removeFirst();
+        void remove(int);
+        void clear();
+        void printList();
+    public:
+        UnrolledLinkedList(bool);
+        friend class ListMenu<UnrolledLinkedList>;
+        void interface();
+};
+
+UnrolledLinkedList::UnrolledLinkedList(bool isSorted){
+    first = nullptr;
+    last = nullptr;
+    this->isSorted = isSorted;
+    size = 0;
+}
+
+// Puts data at index of block, splitting the block in two halves when it is full
+// Time Complexity O(BLOCK_CAPACITY)
+void UnrolledLinkedList::insertInBlock(Block* block, int index, int data){
+    if(block->count == BLOCK_CAPACITY){
+        Block* newBlock = blocks.create();
+        std::copy(block->values + BLOCK_MIN, block->values + BLOCK_CAPACITY, newBlock->values);
+        newBlock->count = BLOCK_CAPACITY - BLOCK_MIN;
+        block->count = BLOCK_MIN;
+        newBlock->next = block->next;
+        block->next = newBlock;
+        if(last == block)
+            last = newBlock;
+        if(index > BLOCK_MIN){
+            block = newBlock;
+            index -= BLOCK_MIN;
+        }
+    }
+    std::copy_backward(block->values + index, block->values + block->count, block->values + block->count + 1);
+    block->values[index] = data;
+    block->count++;
+    size++;
+}
+
+// Removes index of block (preceded by prev), then merges with or borrows from the next block
+// when it falls under half full
+// Time Complexity O(BLOCK_CAPACITY)
+void UnrolledLinkedList::eraseInBlock(Block* block, Block* prev, int index){
+    std::copy(block->values + index + 1, block->values + block->count, block->values + index);
+    block->count--;
+    size--;
+    if(block->count == 0){
+        if(prev == nullptr)
+            first = block->next;
+        else
+            prev->next = block->next;
+        if(last == block)
+            last = prev;
+        blocks.destroy(block);
+        return;
+    }
+    Block* next = block->next;
+    if(block->count >= BLOCK_MIN || next == nullptr)
+        return;
+    if(block->count + next->count <= BLOCK_CAPACITY){
+        std::copy(next->values, next->values + next->count, block->values + block->count);
+        block->count += next->count;
+        block->next = next->next;
+        if(last == next)
+            last = block;
+        blocks.destroy(next);
+    }
+    else{
+        int moved = (next->count - block->count) / 2;
+        std::copy(next->values, next->values + moved, block->values + block->count);
+        std::copy(next->values + moved, next->values + next->count, next->values);
+        block->count += moved;
+        next->count -= moved;
+    }
+}
+
+// Time Complexity O(1)
+void UnrolledLinkedList::insertFirst(int data){
+    if(first == nullptr || first->count == BLOCK_CAPACITY){
+        Block* newBlock = blocks.create();   // Fresh block in front instead of splitting a full one
+        newBlock->next = first;
+        if(first == nullptr)
+            last = newBlock;
+        first = newBlock;
+    }
+    insertInBlock(first, 0, data);
+}
+
+// Time Complexity O(1)
+void UnrolledLinkedList::insertLast(int data){
+    if(last == nullptr || last->count == BLOCK_CAPACITY){
+        Block* newBlock = blocks.create();
+        if(last == nullptr)
+            first = newBlock;
+        else
+            last->next = newBlock;
+        last = newBlock;
+    }
+    insertInBlock(last, last->count, data);
+}
+
+void UnrolledLinkedList::insert(int data, int position){
+    if(isSorted)
+        insertSorted(data);
+    else
+        insertAtPosition(data, position);
+}
+
+// Equal data is kept in insertion order: the new value goes after its duplicates
+// Time Complexity O(n / BLOCK_CAPACITY)
+void UnrolledLinkedList::insertSorted(int data){
+    if(first == nullptr){
+        insertFirst(data);
+        return;
+    }
+    Block* block = first;
+    while(block->next != nullptr && block->next->values[0] <= data)
+        block = block->next;
+    int index = std::upper_bound(block->values, block->values + block->count, data) - block->values;
+    insertInBlock(block, index, data);
+}
+
+// Time Complexity O(n / BLOCK_CAPACITY)
+void UnrolledLinkedList::insertAtPosition(int data, int position){
+    if(position < 0){
+        std::cout << "List doesn't have " << position <<
+            " elements. Inserting at the position: 0" << std::endl;
+        position = 0;
+    }
+    else if(position > size){
+        std::cout << "List doesn't have " << position <<
+            " elements. Inserting at the position: " << size << std::endl;
+        position = size;
+    }
+    if(position == 0){
+        insertFirst(data);
+        return;
+    }
+    if(position == size){
+        insertLast(data);
+        return;
+    }
+    Block* block = first;
+    while(position > block->count){
+        position -= block->count;
+        block = block->next;
+    }
+    insertInBlock(block, position, data);
+}
+
+// Position of the first value equal to data, or -1
+// Time Complexity O(n / SIMD width)
+int UnrolledLinkedList::indexOf(int data){
+    int position = 0;
+    for(Block* block = first; block != nullptr; block = block->next){
+        int index = findInBlock(block, data);
+        if(index != -1)
+            return position + index;
+        position += block->count;
+    }
+    return -1;
+}
+
+// Removes the first value equal to data; false if there is none
+// Time Complexity O(n / SIMD width)
+bool UnrolledLinkedList::erase(int data){
+    Block* prev = nullptr;
+    for(Block* block = first; block != nullptr; prev = block, block = block->next){
+        int index = findInBlock(block, data);
+        if(index != -1){
+            eraseInBlock(block, prev, index);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Time Complexity O(BLOCK_CAPACITY)
+bool UnrolledLinkedList::eraseFirst(){
+    if(first == nullptr)
+        return false;
+    eraseInBlock(first, nullptr, 0);
+    return true;
+}
+
+void UnrolledLinkedList::search(int data){
+    int position = indexOf(data);
+    if(position != -1)
+        std::cout << "Data was found at the position " << position << "\n";
+    else
+        std::cout << "This Data doesn't exist\n";
+}
+
+void UnrolledLinkedList::removeFirst(){
+    if(eraseFirst())
+        std::cout << "Successfully excluded\n";
+    else
+        std::cout << "Data doesn't exists\n";
+}
+
+void UnrolledLinkedList::remove(int data){
+    if(erase(data))
+        std::cout << "Successfully excluded\n";
+    else
+        std::cout << "Data doesn't exists\n";
+}
+
+// Time Complexity O(slabs)
+void UnrolledLinkedList::clear(){
+    blocks.clear();
+    first = nullptr;
+    last = nullptr;
+    size = 0;
+}
+
+// Time Complexity O(n)
+void UnrolledLinkedList::printList(){
+    for(Block* block = first; block != nullptr; block = block->next)
+        for(int i = 0; i < block->count; i++)
+            std::cout << block->values[i] << " -> ";
+    std::cout << "NULL" << std::endl;
+}
+
+void UnrolledLinkedList::interface(){
+    ListMenu<UnrolledLinkedList>::run(*this);
+}
+
+const int MAX_EPOCH_THREADS = 128;   // Threads that may use concurrent lists at the same time
+const int EPOCH_THRESHOLD = 64;      // Retirements between attempts to advance the epoch
+
+// State of one thread: (epoch << 1) | 1 while it is reading a concurrent list, 0 otherwise
+struct EpochRecord {
+    std::atomic<bool> active;        // Owned by a live thread
+    std::atomic<unsigned long> state;
+};
+
+EpochRecord epochRecords[MAX_EPOCH_THREADS];
+std::atomic<unsigned long> globalEpoch(2);
+
+class ConcurrentNode{
+    public:
+        int data;
+        std::atomic<ConcurrentNode*> next;  // Low bit set: this node is logically removed
+        ConcurrentNode(int);
+};
+
+ConcurrentNode::ConcurrentNode(int data) : next(nullptr){
+    this->data = data;
+}
+
+bool isMarked(ConcurrentNode* pointer){
+    return (reinterpret_cast<std::uintptr_t>(pointer) & 1) != 0;
+}
+
+ConcurrentNode* marked(ConcurrentNode* pointer){
+    return reinterpret_cast<ConcurrentNode*>(reinterpret_cast<std::uintptr_t>(pointer) | 1);
+}
+
+ConcurrentNode* unmarked(ConcurrentNode* pointer){
+    return reinterpret_cast<ConcurrentNode*>(reinterpret_cast<std::uintptr_t>(pointer) & ~(std::uintptr_t)1);
+}
+
+struct RetiredNode {
+    unsigned long epoch;             // Global epoch when the node was unlinked
+    ConcurrentNode* node;
+};
+
+// Nodes retired by threads that exited before it was safe to delete them
+struct OrphanList {
+    std::mutex mutex;
+    std::vector<RetiredNode> nodes;
+    ~OrphanList(){                   // Program exit: nobody is reading anymore
+        for(RetiredNode& retired : nodes)
+            delete retired.node;
+    }
+};
+
+OrphanList orphans;
+
+// Epoch-based reclamation: a node unlinked during epoch e is deleted once the global epoch reaches
+// e + 2, because by then every thread that could still see it has left its read section
+class Epoch{
+    private:
+        EpochRecord* record;
+        std::vector<RetiredNode> retired;
+        int sinceAdvance;
+
+    public:
+        Epoch();
+        ~Epoch();
+        void enter();                // Starts a read section
+        void exit();
+        void retire(ConcurrentNode*);
+        void reclaim();
+};
+
+Epoch::Epoch(){
+    record = nullptr;
+    sinceAdvance = 0;
+    for(EpochRecord& candidate : epochRecords){
+        bool expected = false;
+        if(!candidate.active.load(std::memory_order_relaxed) &&
+           candidate.active.compare_exchange_strong(expected, true)){
+            record = &candidate;
+            break;
+        }
+    }
+    if(record == nullptr)
+        throw std::runtime_error("Too many threads using concurrent lists");
+}
+
+Epoch::~Epoch(){
+    reclaim();
+    if(!retired.empty()){
+        std::lock_guard<std::mutex> lock(orphans.mutex);
+        orphans.nodes.insert(orphans.nodes.end(), retired.begin(), retired.end());
+    }
+    record->state.store(0, std::memory_order_release);
+    record->active.store(false, std::memory_order_release);
+}
+
+// Time complexity = O(1)
+void Epoch::enter(){
+    unsigned long epoch = globalEpoch.load(std::memory_order_acquire);
+    record->state.store(epoch << 1 | 1, std::memory_order_seq_cst);  // Visible before any node is read
+}
+
+// Time complexity = O(1)
+void Epoch::exit(){
+    record->state.store(0, std::memory_order_release);
+}
+
+// Time complexity = O(1) amortized
+void Epoch::retire(ConcurrentNode* node){
+    retired.push_back(RetiredNode{globalEpoch.load(std::memory_order_seq_cst), node});
+    if(++sinceAdvance >= EPOCH_THRESHOLD){
+        sinceAdvance = 0;
+        reclaim();
+    }
+}
+
+// Advances the global epoch if every reading thread has caught up, then deletes what became safe
+// Time complexity = O(T + R) for T thread records and R retired nodes
+void Epoch::reclaim(){
+    unsigned long epoch = globalEpoch.load(std::memory_order_seq_cst);
+    bool caughtUp = true;
+    for(EpochRecord& candidate : epochRecords){
+        unsigned long state = candidate.state.load(std::memory_order_seq_cst);
+        if((state & 1) != 0 && (state >> 1) != epoch){
+            caughtUp = false;
+            break;
+        }
+    }
+    if(caughtUp && globalEpoch.compare_exchange_strong(epoch, epoch + 1))
+        epoch++;
+    {
+        std::unique_lock<std::mutex> lock(orphans.mutex, std::try_to_lock);
+        if(lock.owns_lock() && !orphans.nodes.empty()){
+            retired.insert(retired.end(), orphans.nodes.begin(), orphans.nodes.end());
+            orphans.nodes.clear();   // Adopt what exited threads left behind
+        }
+    }
+    std::size_t kept = 0;
+    for(RetiredNode& node : retired){
+        if(node.epoch + 2 <= epoch)
+            delete node.node;
+        else
+            retired[kept++] = node;
+    }
+    retired.resize(kept);
+}
+
+Epoch& threadEpoch(){
+    thread_local Epoch epoch;
+    return epoch;
+}
+
+// Harris-Michael sorted list: removal first marks the node's next pointer, then unlinks it; any
+// thread that walks over a marked node helps unlink it. contains() only reads and never waits.
+class ConcurrentSortedList{
+    private:
+        ConcurrentNode head;         // Sentinel before the first node
+        std::atomic<int> size;
+
+        void find(int, bool, ConcurrentNode*&, ConcurrentNode*&);
+    public:
+        ConcurrentSortedList();
+        ~ConcurrentSortedList();
+        ConcurrentSortedList(const ConcurrentSortedList&) = delete;
+        ConcurrentSortedList& operator=(const ConcurrentSortedList&) = delete;
+        void insertSorted(int);
+        bool remove(int);
+        bool contains(int);
+        int getSize();
+        void printList();
+};
+
+ConcurrentSortedList::ConcurrentSortedList() : head(0), size(0){
+}
+
+ConcurrentSortedList::~ConcurrentSortedList(){
+    ConcurrentNode* aux = unmarked(head.next.load(std::memory_order_relaxed));
+    while(aux != nullptr){
+        ConcurrentNode* next = unmarked(aux->next.load(std::memory_order_relaxed));
+        delete aux;
+        aux = next;
+    }
+}
+
+// Sets prev/curr around the first node whose data is >= data (> data if inclusive), unlinking
+// marked nodes met on the way. Must run inside a read section.
+// Time complexity = O(n)
+void ConcurrentSortedList::find(int data, bool inclusive, ConcurrentNode*& prev, ConcurrentNode*& curr){
+    retry:
+    prev = &head;
+    curr = prev->next.load(std::memory_order_acquire);
+    while(curr != nullptr){
+        ConcurrentNode* next = curr->next.load(std::memory_order_acquire);
+        if(isMarked(next)){
+            ConcurrentNode* expected = curr;
+            if(!prev->next.compare_exchange_strong(expected, unmarked(next)))
+                goto retry;          // prev changed or was removed itself
+            threadEpoch().retire(curr);
+            curr = unmarked(next);
+            continue;
+        }
+        if(curr->data > data || (!inclusive && curr->data == data))
+            return;
+        prev = curr;
+        curr = next;
+    }
+}
+
+// Equal data is kept in insertion order: the new node goes after its duplicates
+// Time complexity = O(n)
+void ConcurrentSortedList::insertSorted(int data){
+    ConcurrentNode* newNode = new ConcurrentNode(data);
+    Epoch& epoch = threadEpoch();
+    epoch.enter();
+    ConcurrentNode* prev;
+    ConcurrentNode* curr;
+    do{
+        find(data, true, prev, curr);
+        newNode->next.store(curr, std::memory_order_relaxed);
+    } while(!prev->next.compare_exchange_weak(curr, newNode, std::memory_order_release));
+    epoch.exit();
+    size.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Removes one node holding data; false if there is none
+// Time complexity = O(n)
+bool ConcurrentSortedList::remove(int data){
+    Epoch& epoch = threadEpoch();
+    epoch.enter();
+    ConcurrentNode* prev;
+    ConcurrentNode* curr;
+    while(true){
+        find(data, false, prev, curr);
+        if(curr == nullptr || curr->data != data){
+            epoch.exit();
+            return false;
+        }
+        ConcurrentNode* next = curr->next.load(std::memory_order_acquire);
+        if(isMarked(next))
+            continue;                // Someone else is removing it: look again
+        if(curr->next.compare_exchange_strong(next, marked(next)))
+            break;                   // Logically removed: from here on it is ours
+    }
+    ConcurrentNode* expected = curr;
+    ConcurrentNode* next = unmarked(curr->next.load(std::memory_order_acquire));
+    if(prev->next.compare_exchange_strong(expected, next))
+        epoch.retire(curr);
+    else
+        find(data, false, prev, curr);  // Let the walk unlink it
+    epoch.exit();
+    size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Time complexity = O(n)
+bool ConcurrentSortedList::contains(int data){
+    Epoch& epoch = threadEpoch();
+    epoch.enter();
+    ConcurrentNode* aux = unmarked(head.next.load(std::memory_order_acquire));
+    while(aux != nullptr && aux->data < data)
+        aux = unmarked(aux->next.load(std::memory_order_acquire));
+    while(aux != nullptr && aux->data == data && isMarked(aux->next.load(std::memory_order_acquire)))
+        aux = unmarked(aux->next.load(std::memory_order_acquire));  // Skip removed duplicates
+    bool found = aux != nullptr && aux->data == data;
+    epoch.exit();
+    return found;
+}
+
+int ConcurrentSortedList::getSize(){
+    return size.load(std::memory_order_relaxed);
+}
+
+// Time complexity = O(n)
+void ConcurrentSortedList::printList(){
+    Epoch& epoch = threadEpoch();
+    epoch.enter();
+    for(ConcurrentNode* aux = unmarked(head.next.load(std::memory_order_acquire)); aux != nullptr;){
+        ConcurrentNode* next = aux->next.load(std::memory_order_acquire);
+        if(!isMarked(next))
+            std::cout << aux->data << " -> ";
+        aux = unmarked(next);
+    }
+    std::cout << "NULL" << std::endl;
+    epoch.exit();
+}
+
+// Threads share a sorted list of about KEYS / 2 values: half of the operations search, a quarter
+// insert a missing key and a quarter remove. The coarse version is a LinkedList behind one mutex.
+void benchmarkLists(){
+    const int OPERATIONS = 1 << 19;  // Operations shared by all threads
+    const int KEYS = 2048;
+    std::cout << "threads  locked LinkedList (Mops/s)  ConcurrentSortedList (Mops/s)\n";
+    for(int threads = 1; threads <= 64; threads *= 2){
+        auto run = [&](auto insert, auto remove, auto contains){
+            std::vector<std::thread> pool;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for(int t = 0; t < threads; t++)
+                pool.emplace_back([&, t]{
+                    std::minstd_rand random(t + 1);
+                    for(int i = 0; i < OPERATIONS / threads; i++){
+                        int key = (int)(random() % KEYS);
+                        switch(random() % 4){
+                            case 0: if(!contains(key)) insert(key); break;  // Keeps the size steady
+                            case 1: remove(key); break;
+                            default: contains(key);
+                        }
+                    }
+                });
+            for(std::thread& thread : pool)
+                thread.join();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return (double)(OPERATIONS / threads) * threads / seconds / 1e6;
+        };
+
+        std::mutex mutex;
+        LinkedList locked(true);
+        for(int key = 0; key < KEYS; key += 2)
+            locked.insertSorted(key);
+        double lockedRate = run([&](int key){ std::lock_guard<std::mutex> lock(mutex); locked.insertSorted(key); },
+                                [&](int key){ std::lock_guard<std::mutex> lock(mutex); locked.erase(key); },
+                                [&](int key){ std::lock_guard<std::mutex> lock(mutex); return locked.indexOf(key) != -1; });
+
+        ConcurrentSortedList lockFree;
+        for(int key = 0; key < KEYS; key += 2)
+            lockFree.insertSorted(key);
+        double lockFreeRate = run([&](int key){ lockFree.insertSorted(key); },
+                                  [&](int key){ lockFree.remove(key); },
+                                  [&](int key){ return lockFree.contains(key); });
+
+        std::cout << threads << "\t " << lockedRate << "\t\t\t\t" << lockFreeRate << "\n";
+    }
+}
+
+int main(int argc, char* argv[]){
+    if(argc > 1 && std::string(argv[1]) == "--bench"){
+        benchmarkLists();
+        return 0;
+    }
+    int listType;
     std::cout << "What type of list do you want to create?"
-    << "\n0-Unordered 1-Ordered\n";
-    std::cin >> isSorted;
-    if(isSorted == 0){
-        LinkedList list(false);
+    << "\n0-Unordered 1-Ordered 2-Unrolled unordered 3-Unrolled ordered 4-Indexed unordered\n";
+    std::cin >> listType;
+    if(listType == 2 || listType == 3){
+        UnrolledLinkedList list(listType == 3);
+        list.interface();
+    }
+    else if(listType == 0 || listType == 4){
+        LinkedList list(false, listType == 4);
         list.interface();
     }
     else{
@@ -7,31 +7,86 @@ Data Structures and Algorithms - Stack
 /*
  *
  * @file stack.cpp
- * @brief Implementation of a stack data structure using a singly linked list and
+ * @brief Implementation of a stack data structure using contiguous chunks of memory and
  * a function to verify if a sequence of parentheses and brackets is well-formed.
  *
  * The file contains:
- * - A templated Node class to represent each element in the stack.
  * - A templated Stack class that provides common stack operations such as push, pop, top, and size.
  * - A function `isWellFormed` to check if a sequence of parentheses and brackets is well-formed.
  *
- * @class Node
- * @tparam T The type of the element stored in the node.
- * @brief Represents a node in the linked list with an element of type T and a pointer to the next node.
- *
  * @class Stack
  * @tparam T The type of the elements stored in the stack.
- * @brief Implements a stack data structure using a singly linked list.
+ * @tparam N Number of elements stored inline in the Stack object itself (0 = none).
+ * @brief Implements a stack data structure using geometrically growing contiguous chunks.
+ *
+ * Chunk i holds B * 2^i elements, where B is N (or 16 when N is 0). With N > 0, chunk 0 is a buffer inside
+ * the object, so a stack that never holds more than N elements does zero heap allocations. With N = 0 the
+ * object is only a few pointers and counters: chunk 0 is allocated by the first push, and the table of the
+ * other chunks when chunk 0 first overflows. A new chunk is allocated only when every chunk is full, and
+ * chunks are kept when the stack shrinks.
  *
  * The Stack class provides the following methods:
  * - `Stack()` - Constructor to initialize an empty stack.
  * - `bool empty()` - Returns true if the stack is empty, false otherwise.
- * - `T pop()` - Removes and returns the top element of the stack. Throws an exception if the stack is empty.
- * - `T top()` - Returns the top element of the stack without removing it. Throws an exception if the stack is empty.
- * - `void push(T data)` - Adds an element to the top of the stack.
+ * - `T pop()` - Removes the top element of the stack and returns it by moving it out. Throws an exception if the stack is empty.
+ * - `T& top()` - Returns the top element of the stack without removing it. Throws an exception if the stack is empty.
+ * - `void push(const T& data)` / `void push(T&& data)` - Adds an element to the top of the stack, copying or moving it.
+ * - `void emplace(Args&&... args)` - Constructs an element in place on the top of the stack.
  * - `int getSize()` - Returns the number of elements in the stack.
  *
- * @function bool isWellFormed(std::string sequence)
+ * @class ConcurrentStack
+ * @tparam T The type of the elements stored in the stack.
+ * @brief Lock-free (Treiber) stack that can be shared by many threads without a mutex.
+ *
+ * Popped nodes are reclaimed with hazard pointers: a thread publishes the node it is about to read, and
+ * retired nodes are only deleted once no thread publishes them. This also rules out the ABA problem,
+ * because a node can't be freed and reused while a pop still compares against it. When the CAS on the top
+ * fails under contention, the thread tries an elimination array: a push parks its node in a random slot for
+ * a short while and a pop that finds it takes it directly, so the pair cancels out without touching the top.
+ * - `void push(T data)` - Adds an element to the top of the stack.
+ * - `bool tryPop(T& value)` - Moves the top element into value; returns false if the stack is empty.
+ * - `T pop()` - Removes and returns the top element. Throws an exception if the stack is empty.
+ * - `bool empty()` / `int getSize()` - Snapshot of the state; may be stale as soon as it returns.
+ *
+ * @class HazardPointer
+ * @brief Per-thread hazard pointer slot plus the list of nodes that thread retired.
+ *
+ * @function void benchmarkStacks()
+ * @brief Measures push/pop throughput of ConcurrentStack against a mutex-wrapped Stack for 1 to 64
+ * threads. Run the program with `--bench` to execute it.
+ *
+ * @class BracketValidator
+ * @brief Streaming bracket checker: input is fed block by block and only the stack of open brackets is kept.
+ *
+ * Each block is classified with SIMD compares (64 bytes at a time with AVX-512BW, 32 with AVX2, 16 with
+ * SSE2), producing a bit mask of the bracket bytes; only those bytes reach the stack logic. With GCC or Clang
+ * on x86 the widest kernel the CPU supports is chosen at run time, so no -m flags are needed; other
+ * compilers use the kernel their flags enable (e.g. /arch:AVX2).
+ * - `bool feed(const char* data, std::size_t length)` - Processes the next block; false once a mismatch is found.
+ * - `long long finish()` - Byte offset of the first mismatch, the input length if brackets are left open,
+ *   or -1 if the input is well-formed.
+ *
+ * @function long long firstBracketMismatch(std::FILE* input)
+ * @brief Validates a whole file (or stdin) in fixed-size blocks, with memory bounded by the block size
+ * plus the nesting depth. Returns the same value as BracketValidator::finish. Run the program with
+ * `--validate <file>` (or `--validate -` for stdin) to execute it.
+ *
+ * @struct BracketSummary
+ * @brief What a chunk leaves unresolved: the closers it could not match (one byte each, plus the offset of
+ * the first), the openers still open at its end, and the offset of a mismatch found inside it (-1 if none).
+ * Summaries of adjacent chunks combine associatively: the right chunk's closers are matched against the left
+ * chunk's openers. When the offset of another closer is needed, the right chunk is scanned again.
+ *
+ * @function long long firstBracketMismatchParallel(const char* data, std::size_t length, unsigned threads)
+ * @brief Splits the input into one chunk per thread, summarizes the chunks concurrently and combines the
+ * summaries with a parallel pairwise reduction. Returns the same value as BracketValidator::finish.
+ *
+ * @function long long firstBracketMismatchParallel(std::FILE* input, unsigned threads)
+ * @brief File version: reads large segments, validates each one in parallel and folds its summary into
+ * the running one, stopping at the first mismatch. Run the program with `--validate <file> <threads>`
+ * to execute it; anything but a whole number of at least 1 prints the usage instead.
+ *
+ * @function bool isWellFormed(const std::string& sequence)
  * @brief Checks if a given sequence of parentheses and brackets is well-formed.
  * @param sequence The string containing the sequence of parentheses and brackets.
  * @return Returns true if the sequence is well-formed, false otherwise.
@@ -42,58 +97,120 @@ Data Structures and Algorithms - Stack
 
 
 #include <iostream>
-#include <unordered_map>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <new>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512BW__) || \
+    ((defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)))
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
-template <typename T>
-class Node{
-    public:
-        T element;
-        Node *next;
-        Node(T);
+// Chunk 0 of a Stack with N > 0, stored inside the stack object
+template <typename T, std::size_t N>
+struct StackInlineChunk{
+    alignas(T) unsigned char inline_buffer[N * sizeof(T)];
+    T* inlineChunk(){ return reinterpret_cast<T*>(inline_buffer); }
 };
 
+// With N = 0 there is no inline chunk, and as an empty base this takes no space in the stack
 template <typename T>
-Node<T>::Node(T element){
-    this->element = element;
-    next = nullptr;
-}
+struct StackInlineChunk<T, 0>{
+    T* inlineChunk(){ return nullptr; }
+};
 
-template <typename T>
-class Stack{
+template <typename T, std::size_t N = 0>
+class Stack : private StackInlineChunk<T, N>{
     private:
-        Node<T>* first;
+        static const std::size_t FIRST_CHUNK = N > 0 ? N : 16;  // Elements in chunk 0; every next chunk is twice as big
+        static const int MAX_CHUNKS = 32;  // Enough chunks for more than INT_MAX elements
+        T* first_chunk;              // Chunk 0: the inline buffer, or allocated by the first push when N is 0
+        T** more_chunks;             // Chunks 1 and up, kept when the stack shrinks; allocated when chunk 0 overflows
+        T* top_chunk;                // Chunk holding the top element, nullptr before the first push when N is 0
+        int allocated;               // Number of chunks allocated so far, chunk 0 included
+        int chunk;                   // Index of top_chunk
+        std::size_t offset;          // Elements used in that chunk
         int size;
+        std::allocator<T> allocator;
+
+        static std::size_t capacity(int);  // Number of elements chunk i can hold
 
     public:
         Stack();
+        ~Stack();
+        Stack(const Stack&) = delete;
+        Stack& operator=(const Stack&) = delete;
         bool empty();
         T pop();
-        T top();
-        void push(T);
+        T& top();
+        void push(const T&);
+        void push(T&&);
+        template <typename... Args>
+        void emplace(Args&&...);
         int getSize();
 };
 
-template <typename T>
-Stack<T>::Stack(){
-    first = nullptr;
+template <typename T, std::size_t N>
+Stack<T, N>::Stack(){
+    first_chunk = this->inlineChunk();
+    more_chunks = nullptr;
+    top_chunk = first_chunk;
+    allocated = N > 0 ? 1 : 0;
+    chunk = 0;
+    offset = 0;
     size = 0;
 }
 
+template <typename T, std::size_t N>
+Stack<T, N>::~Stack(){
+    while(!empty())
+        pop();
+    if(N == 0 && allocated > 0)      // The inline chunk isn't owned by the allocator
+        allocator.deallocate(first_chunk, capacity(0));
+    for(int i = 1; i < allocated; i++)
+        allocator.deallocate(more_chunks[i - 1], capacity(i));
+    delete[] more_chunks;
+}
+
+template <typename T, std::size_t N>
+std::size_t Stack<T, N>::capacity(int i){
+    return FIRST_CHUNK << i;
+}
+
 // Time complexity = O(1)
-template <typename T>
-bool Stack<T>::empty(){
-    return first == nullptr;
+template <typename T, std::size_t N>
+bool Stack<T, N>::empty(){
+    return size == 0;
 }
 
 // Time complexity = O(1)
-template <typename T>
-T Stack<T>::pop(){
+template <typename T, std::size_t N>
+T Stack<T, N>::pop(){
     if(!empty()){
-        Node<T>* aux = first;
-        T value = first->element;
-        first = first->next;
+        T* slot = top_chunk + offset - 1;
+        T value = std::move(*slot);
+        slot->~T();
         size--;
-        delete aux;
+        if(--offset == 0 && chunk > 0){
+            chunk--;                 // Top moves back to the (full) previous chunk
+            top_chunk = chunk == 0 ? first_chunk : more_chunks[chunk - 1];
+            offset = capacity(chunk);
+        }
         return value;
     }
     else
@@ -101,53 +218,748 @@ T Stack<T>::pop(){
 }
 
 // Time complexity = O(1)
-template <typename T>
-T Stack<T>::top(){
+template <typename T, std::size_t N>
+T& Stack<T, N>::top(){
     if(!empty())
-        return first->element;
+        return top_chunk[offset - 1];
     else
         throw std::out_of_range("Stack is empty");
 }
 
 // Time complexity = O(1)
-template <typename T>
-void Stack<T>::push(T data){
-    Node<T>* newNode = new Node<T>(data);
-    newNode->next = first;
-    first = newNode;
+template <typename T, std::size_t N>
+void Stack<T, N>::push(const T& data){
+    emplace(data);
+}
+
+// Time complexity = O(1)
+template <typename T, std::size_t N>
+void Stack<T, N>::push(T&& data){
+    emplace(std::move(data));
+}
+
+// Time complexity = O(1) amortized: a chunk is allocated only the first time the stack gets that deep
+template <typename T, std::size_t N>
+template <typename... Args>
+void Stack<T, N>::emplace(Args&&... args){
+    int next_chunk = chunk;
+    std::size_t next_offset = offset;
+    T* next_top = top_chunk;
+    if(top_chunk == nullptr){        // First push with N = 0
+        first_chunk = allocator.allocate(capacity(0));
+        allocated = 1;
+        next_top = first_chunk;
+    } else if(offset == capacity(chunk)){
+        next_chunk++;
+        next_offset = 0;
+        if(next_chunk == allocated){
+            if(allocated == MAX_CHUNKS)
+                throw std::length_error("Stack is full");
+            if(more_chunks == nullptr)
+                more_chunks = new T*[MAX_CHUNKS - 1];
+            more_chunks[allocated - 1] = allocator.allocate(capacity(next_chunk));
+            allocated++;
+        }
+        next_top = more_chunks[next_chunk - 1];
+    }
+    // The position only changes once the element is built, so a throwing constructor leaves the stack intact
+    ::new ((void*)(next_top + next_offset)) T(std::forward<Args>(args)...);
+    top_chunk = next_top;
+    chunk = next_chunk;
+    offset = next_offset + 1;
     size++;
 }
 
 // Time complexity = O(1)
-template <typename T>
-int Stack<T>::getSize(){
+template <typename T, std::size_t N>
+int Stack<T, N>::getSize(){
     return size;
 }
 
-// Function used to verify if a sequence of parentheses/brackets is well-formed
-bool isWellFormed(std::string sequence){
-    Stack<char> stack;
-
-    std::unordered_map<char, char> matchingBrackets = {
-        {')', '('},
-        {']', '['},
-        {'}', '{'}
-    };
-
-    for(char ch : sequence){
-        if (ch == '(' || ch == '{' || ch == '[') {
-            stack.push(ch);
-        } else if (ch == ')' || ch == '}' || ch == ']') {
-            if (stack.empty() || stack.top() != matchingBrackets[ch]) {
+const int MAX_HAZARD_THREADS = 128;  // Threads that may use concurrent stacks at the same time
+const std::size_t RETIRE_THRESHOLD = 2 * MAX_HAZARD_THREADS;  // Retired nodes kept before a scan
+
+struct HazardRecord {
+    std::atomic<bool> active;        // Owned by a live thread
+    std::atomic<void*> pointer;      // Node that thread is reading, or nullptr
+};
+
+HazardRecord hazardRecords[MAX_HAZARD_THREADS];
+
+struct RetiredNode {
+    void* node;
+    void (*destroy)(void*);          // Deletes the node with its real type
+};
+
+// Nodes retired by threads that exited while another thread still protected them
+struct OrphanList {
+    std::mutex mutex;
+    std::vector<RetiredNode> nodes;
+    ~OrphanList(){                   // Program exit: no thread can hold a hazard pointer anymore
+        for(RetiredNode& retired : nodes)
+            retired.destroy(retired.node);
+    }
+};
+
+OrphanList orphans;
+
+class HazardPointer{
+    private:
+        HazardRecord* record;
+        std::vector<RetiredNode> retired;
+
+    public:
+        HazardPointer();
+        ~HazardPointer();
+        void protect(void*);         // Publishes the node about to be read
+        void clear();
+        void retire(void*, void (*)(void*));  // Deletes the node once no thread protects it
+        void scan();
+};
+
+HazardPointer::HazardPointer(){
+    record = nullptr;
+    for(HazardRecord& candidate : hazardRecords){
+        bool expected = false;
+        if(!candidate.active.load(std::memory_order_relaxed) &&
+           candidate.active.compare_exchange_strong(expected, true)){
+            record = &candidate;
+            break;
+        }
+    }
+    if(record == nullptr)
+        throw std::runtime_error("Too many threads using concurrent stacks");
+}
+
+HazardPointer::~HazardPointer(){
+    clear();
+    scan();
+    if(!retired.empty()){
+        std::lock_guard<std::mutex> lock(orphans.mutex);
+        orphans.nodes.insert(orphans.nodes.end(), retired.begin(), retired.end());
+    }
+    record->active.store(false, std::memory_order_release);
+}
+
+// Time complexity = O(1)
+void HazardPointer::protect(void* node){
+    record->pointer.store(node, std::memory_order_seq_cst);  // Must be visible before the node is re-checked
+}
+
+// Time complexity = O(1)
+void HazardPointer::clear(){
+    record->pointer.store(nullptr, std::memory_order_release);
+}
+
+// Time complexity = O(1) amortized
+void HazardPointer::retire(void* node, void (*destroy)(void*)){
+    retired.push_back(RetiredNode{node, destroy});
+    if(retired.size() >= RETIRE_THRESHOLD)
+        scan();
+}
+
+// Time complexity = O(R log H) for R retired nodes and H hazard records
+void HazardPointer::scan(){
+    {
+        std::unique_lock<std::mutex> lock(orphans.mutex, std::try_to_lock);
+        if(lock.owns_lock() && !orphans.nodes.empty()){
+            retired.insert(retired.end(), orphans.nodes.begin(), orphans.nodes.end());
+            orphans.nodes.clear();   // Adopt what exited threads left behind
+        }
+    }
+    std::vector<void*> protected_nodes;
+    for(HazardRecord& candidate : hazardRecords){
+        void* node = candidate.pointer.load(std::memory_order_seq_cst);
+        if(node != nullptr)
+            protected_nodes.push_back(node);
+    }
+    std::sort(protected_nodes.begin(), protected_nodes.end());
+    std::size_t kept = 0;
+    for(RetiredNode& node : retired){
+        if(std::binary_search(protected_nodes.begin(), protected_nodes.end(), node.node))
+            retired[kept++] = node;  // Still being read by someone
+        else
+            node.destroy(node.node);
+    }
+    retired.resize(kept);
+}
+
+HazardPointer& threadHazard(){
+    thread_local HazardPointer hazard;
+    return hazard;
+}
+
+template <typename T>
+class ConcurrentStack{
+    private:
+        struct Node {
+            T element;
+            Node* next;
+        };
+        struct alignas(64) EliminationSlot {
+            std::atomic<Node*> node;  // nullptr = free, a node = parked push, taken() = a pop took the node
+        };
+        static const int ELIMINATION_SLOTS = 16;
+        static const int ELIMINATION_SPINS = 128;
+
+        alignas(64) std::atomic<Node*> head;
+        alignas(64) std::atomic<int> size;
+        EliminationSlot elimination[ELIMINATION_SLOTS];
+
+        static Node* taken();                // Marker left in a slot by the pop that took its node
+        static void destroy(void*);
+        static int randomSlot();
+        bool eliminatePush(Node*);
+        bool eliminatePop(T&);
+
+    public:
+        ConcurrentStack();
+        ~ConcurrentStack();
+        ConcurrentStack(const ConcurrentStack&) = delete;
+        ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+        void push(T);
+        bool tryPop(T&);
+        T pop();
+        bool empty();
+        int getSize();
+};
+
+template <typename T>
+ConcurrentStack<T>::ConcurrentStack(){
+    head.store(nullptr);
+    size.store(0);
+    for(EliminationSlot& slot : elimination)
+        slot.node.store(nullptr);
+}
+
+// Must not run while other threads still use the stack
+template <typename T>
+ConcurrentStack<T>::~ConcurrentStack(){
+    Node* node = head.load();
+    while(node != nullptr){
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+template <typename T>
+typename ConcurrentStack<T>::Node* ConcurrentStack<T>::taken(){
+    static char marker;
+    return reinterpret_cast<Node*>(&marker);
+}
+
+template <typename T>
+void ConcurrentStack<T>::destroy(void* node){
+    delete static_cast<Node*>(node);
+}
+
+template <typename T>
+int ConcurrentStack<T>::randomSlot(){
+    thread_local unsigned state = (unsigned)std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+    state ^= state << 13;            // xorshift32
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % ELIMINATION_SLOTS;
+}
+
+// Time complexity = O(1) expected, lock-free
+template <typename T>
+void ConcurrentStack<T>::push(T data){
+    Node* node = new Node{std::move(data), nullptr};
+    while(true){
+        Node* old = head.load(std::memory_order_relaxed);
+        node->next = old;
+        if(head.compare_exchange_weak(old, node, std::memory_order_release, std::memory_order_relaxed))
+            break;
+        if(eliminatePush(node))
+            break;                   // A concurrent pop took the node directly
+    }
+    size.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Time complexity = O(1) expected, lock-free
+template <typename T>
+bool ConcurrentStack<T>::tryPop(T& value){
+    HazardPointer& hazard = threadHazard();
+    while(true){
+        Node* old = head.load(std::memory_order_acquire);
+        if(old == nullptr){
+            hazard.clear();
+            return false;
+        }
+        hazard.protect(old);
+        if(head.load(std::memory_order_acquire) != old)
+            continue;                // old may have been freed before it was protected
+        Node* next = old->next;
+        if(head.compare_exchange_strong(old, next, std::memory_order_acq_rel, std::memory_order_relaxed)){
+            hazard.clear();
+            value = std::move(old->element);  // Other readers only look at old->next
+            hazard.retire(old, destroy);
+            size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        hazard.clear();
+        if(eliminatePop(value)){
+            size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+template <typename T>
+T ConcurrentStack<T>::pop(){
+    T value;
+    if(!tryPop(value))
+        throw std::out_of_range("Stack is empty");
+    return value;
+}
+
+template <typename T>
+bool ConcurrentStack<T>::eliminatePush(Node* node){
+    EliminationSlot& slot = elimination[randomSlot()];
+    Node* expected = nullptr;
+    if(!slot.node.compare_exchange_strong(expected, node))
+        return false;                // Slot busy: go back to the top of the stack
+    for(int i = 0; i < ELIMINATION_SPINS; i++){
+        if(slot.node.load(std::memory_order_acquire) == taken()){
+            slot.node.store(nullptr, std::memory_order_release);
+            return true;
+        }
+    }
+    expected = node;
+    if(slot.node.compare_exchange_strong(expected, nullptr))
+        return false;                // Nobody came: withdraw the offer
+    slot.node.store(nullptr, std::memory_order_release);  // A pop took it at the last moment
+    return true;
+}
+
+template <typename T>
+bool ConcurrentStack<T>::eliminatePop(T& value){
+    EliminationSlot& slot = elimination[randomSlot()];
+    Node* node = slot.node.load(std::memory_order_acquire);
+    if(node == nullptr || node == taken())
+        return false;
+    if(!slot.node.compare_exchange_strong(node, taken()))
+        return false;
+    value = std::move(node->element);
+    delete node;                     // A parked node was never on the stack, so nobody else can read it
+    return true;
+}
+
+// Time complexity = O(1)
+template <typename T>
+bool ConcurrentStack<T>::empty(){
+    return head.load(std::memory_order_acquire) == nullptr;
+}
+
+// Time complexity = O(1)
+template <typename T>
+int ConcurrentStack<T>::getSize(){
+    return size.load(std::memory_order_relaxed);
+}
+
+// Function used to compare ConcurrentStack with a Stack protected by a mutex
+void benchmarkStacks(){
+    const int OPERATIONS = 1 << 21;  // push + pop pairs shared by all threads
+    const int PREFILL = 1024;
+    std::cout << "threads  mutex Stack (Mops/s)  ConcurrentStack (Mops/s)\n";
+    for(int threads = 1; threads <= 64; threads *= 2){
+        auto run = [&](auto push, auto pop){
+            std::vector<std::thread> pool;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for(int t = 0; t < threads; t++)
+                pool.emplace_back([&, t]{
+                    for(int i = 0; i < OPERATIONS / threads; i++){
+                        push(t * OPERATIONS + i);
+                        pop();
+                    }
+                });
+            for(std::thread& thread : pool)
+                thread.join();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return 2.0 * (OPERATIONS / threads) * threads / seconds / 1e6;
+        };
+
+        std::mutex mutex;
+        Stack<int> locked;
+        for(int i = 0; i < PREFILL; i++)
+            locked.push(i);
+        double locked_rate = run([&](int value){ std::lock_guard<std::mutex> lock(mutex); locked.push(value); },
+                                 [&]{ std::lock_guard<std::mutex> lock(mutex); if(!locked.empty()) locked.pop(); });
+
+        ConcurrentStack<int> lock_free;
+        for(int i = 0; i < PREFILL; i++)
+            lock_free.push(i);
+        double lock_free_rate = run([&](int data){ lock_free.push(data); },
+                                    [&]{ int popped; lock_free.tryPop(popped); });
+
+        std::cout << threads << "\t " << locked_rate << "\t\t\t" << lock_free_rate << "\n";
+    }
+}
+
+const std::size_t VALIDATOR_BLOCK_SIZE = 1 << 20;  // Bytes read at a time by firstBracketMismatch
+
+// Index of the lowest set bit (mask must not be 0)
+int lowestBit(std::uint64_t mask){
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// GCC and Clang on x86 compile every SIMD kernel below and pick one at run time from the CPU
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BRACKET_SIMD_DISPATCH
+#define BRACKET_TARGET(isa) __attribute__((target(isa)))
+#else
+#define BRACKET_TARGET(isa)          // Other compilers only get the kernel enabled by their build flags
+#endif
+
+#if defined(BRACKET_SIMD_DISPATCH) || defined(__AVX512BW__)
+// Visits the brackets of the 64-byte blocks of data starting at i; i ends at the first byte left over
+template <typename F>
+BRACKET_TARGET("avx512f,avx512bw") bool scanBrackets512(const char* data, std::size_t length, std::size_t& i, F& visit){
+    const __m512i brackets[6] = {_mm512_set1_epi8('('), _mm512_set1_epi8(')'), _mm512_set1_epi8('['),
+                                 _mm512_set1_epi8(']'), _mm512_set1_epi8('{'), _mm512_set1_epi8('}')};
+    for(; i + 64 <= length; i += 64){
+        __m512i bytes = _mm512_loadu_si512((const void*)(data + i));
+        std::uint64_t mask = 0;
+        for(const __m512i& bracket : brackets)
+            mask |= _mm512_cmpeq_epi8_mask(bytes, bracket);
+        for(; mask != 0; mask &= mask - 1)
+            if(!visit(i + lowestBit(mask)))
                 return false;
-            }
-            stack.pop();
+    }
+    return true;
+}
+#endif
+
+#if defined(BRACKET_SIMD_DISPATCH) || defined(__AVX2__)
+// Same as scanBrackets512 with 32-byte blocks
+template <typename F>
+BRACKET_TARGET("avx2") bool scanBrackets256(const char* data, std::size_t length, std::size_t& i, F& visit){
+    const __m256i brackets[6] = {_mm256_set1_epi8('('), _mm256_set1_epi8(')'), _mm256_set1_epi8('['),
+                                 _mm256_set1_epi8(']'), _mm256_set1_epi8('{'), _mm256_set1_epi8('}')};
+    for(; i + 32 <= length; i += 32){
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i hits = _mm256_setzero_si256();
+        for(const __m256i& bracket : brackets)
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(bytes, bracket));
+        for(std::uint64_t mask = (std::uint32_t)_mm256_movemask_epi8(hits); mask != 0; mask &= mask - 1)
+            if(!visit(i + lowestBit(mask)))
+                return false;
+    }
+    return true;
+}
+#endif
+
+#if defined(BRACKET_SIMD_DISPATCH) || defined(__SSE2__)
+// Same as scanBrackets512 with 16-byte blocks
+template <typename F>
+BRACKET_TARGET("sse2") bool scanBrackets128(const char* data, std::size_t length, std::size_t& i, F& visit){
+    const __m128i brackets[6] = {_mm_set1_epi8('('), _mm_set1_epi8(')'), _mm_set1_epi8('['),
+                                 _mm_set1_epi8(']'), _mm_set1_epi8('{'), _mm_set1_epi8('}')};
+    for(; i + 16 <= length; i += 16){
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i hits = _mm_setzero_si128();
+        for(const __m128i& bracket : brackets)
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, bracket));
+        for(std::uint64_t mask = (std::uint32_t)_mm_movemask_epi8(hits); mask != 0; mask &= mask - 1)
+            if(!visit(i + lowestBit(mask)))
+                return false;
+    }
+    return true;
+}
+#endif
+
+#ifdef BRACKET_SIMD_DISPATCH
+// Widest SIMD block, in bytes, the running CPU supports (0 without SSE2); computed once
+int bracketSimdWidth(){
+    static const int width = __builtin_cpu_supports("avx512bw") ? 64 :
+                             __builtin_cpu_supports("avx2") ? 32 :
+                             __builtin_cpu_supports("sse2") ? 16 : 0;
+    return width;
+}
+#endif
+
+// Calls visit(index) for every bracket byte of data, in order, until visit returns false
+template <typename F>
+bool forEachBracket(const char* data, std::size_t length, F visit){
+    std::size_t i = 0;
+    bool more = true;
+#if defined(BRACKET_SIMD_DISPATCH)
+    switch(bracketSimdWidth()){
+        case 64: more = scanBrackets512(data, length, i, visit); break;
+        case 32: more = scanBrackets256(data, length, i, visit); break;
+        case 16: more = scanBrackets128(data, length, i, visit); break;
+    }
+#elif defined(__AVX512BW__)
+    more = scanBrackets512(data, length, i, visit);
+#elif defined(__AVX2__)
+    more = scanBrackets256(data, length, i, visit);
+#elif defined(__SSE2__)
+    more = scanBrackets128(data, length, i, visit);
+#endif
+    if(!more)
+        return false;
+    for(; i < length; i++){          // Tail of the block (or every byte without SIMD)
+        char ch = data[i];
+        if(ch == '(' || ch == ')' || ch == '[' || ch == ']' || ch == '{' || ch == '}')
+            if(!visit(i))
+                return false;
+    }
+    return true;
+}
+
+// Opening bracket that matches a closing one
+char matchingOpener(char closer){
+    return closer == ')' ? '(' : closer == ']' ? '[' : '{';
+}
+
+class BracketValidator{
+    private:
+        Stack<char, 256> openers;    // Brackets still open, innermost on top
+        long long offset;            // Bytes fed so far
+        long long mismatch;          // Offset of the first mismatch, -1 while there is none
+
+    public:
+        BracketValidator();
+        bool feed(const char*, std::size_t);
+        long long finish();
+};
+
+BracketValidator::BracketValidator(){
+    offset = 0;
+    mismatch = -1;
+}
+
+// Time complexity = O(length / SIMD width + brackets in the block)
+bool BracketValidator::feed(const char* data, std::size_t length){
+    if(mismatch != -1)
+        return false;
+    forEachBracket(data, length, [&](std::size_t i){
+        char ch = data[i];
+        if(ch == '(' || ch == '[' || ch == '{'){
+            openers.push(ch);
+            return true;
         }
+        if(openers.empty() || openers.top() != matchingOpener(ch)){
+            mismatch = offset + (long long)i;
+            return false;
+        }
+        openers.pop();
+        return true;
+    });
+    offset += length;
+    return mismatch == -1;
+}
+
+// Time complexity = O(1)
+long long BracketValidator::finish(){
+    if(mismatch != -1)
+        return mismatch;
+    return openers.empty() ? -1 : offset;  // Unclosed brackets: the input ended where a closer was expected
+}
+
+// Function used to validate a whole stream without loading it in memory
+long long firstBracketMismatch(std::FILE* input){
+    std::vector<char> buffer(VALIDATOR_BLOCK_SIZE);
+    BracketValidator validator;
+    std::size_t length;
+    while((length = std::fread(buffer.data(), 1, buffer.size(), input)) > 0)
+        if(!validator.feed(buffer.data(), length))
+            break;                   // The answer is known: stop reading
+    if(std::ferror(input))
+        throw std::runtime_error("Error while reading the input");
+    return validator.finish();
+}
+
+const std::size_t PARALLEL_SEGMENT_SIZE = 64 << 20;  // Bytes of a file validated at a time in parallel
+
+struct BracketSummary {
+    std::vector<char> closers;       // Unmatched closing brackets, in order
+    long long first_closer = -1;     // Offset of closers[0]
+    std::vector<char> openers;       // Brackets still open at the end, innermost last
+    long long error = -1;            // Offset of a mismatch inside the chunk
+    const char* data = nullptr;      // Bytes the chunk covers, scanned again to locate a closer
+    long long base = 0;              // Offset of data[0] in the input
+    std::size_t length = 0;
+};
+
+// Time complexity = O(length / SIMD width + brackets in the chunk)
+BracketSummary summarizeBrackets(const char* data, std::size_t length, long long base){
+    BracketSummary summary;
+    summary.data = data;
+    summary.base = base;
+    summary.length = length;
+    forEachBracket(data, length, [&](std::size_t i){
+        char ch = data[i];
+        if(ch == '(' || ch == '[' || ch == '{'){
+            summary.openers.push_back(ch);
+        } else if(summary.openers.empty()){
+            if(summary.closers.empty())
+                summary.first_closer = base + (long long)i;
+            summary.closers.push_back(ch);  // May match an opener of an earlier chunk
+        } else if(summary.openers.back() != matchingOpener(ch)){
+            summary.error = base + (long long)i;
+            return false;            // Everything after the mismatch is irrelevant
+        } else {
+            summary.openers.pop_back();
+        }
+        return true;
+    });
+    return summary;
+}
+
+// Offset of the unmatched closer number k of a summary, found by scanning its bytes again
+// Time complexity = O(length of the chunk / SIMD width + brackets in it)
+long long closerOffset(const BracketSummary& summary, std::size_t k){
+    std::vector<char> openers;
+    long long offset = -1;
+    forEachBracket(summary.data, summary.length, [&](std::size_t i){
+        char ch = summary.data[i];
+        if(ch == '(' || ch == '[' || ch == '{')
+            openers.push_back(ch);
+        else if(!openers.empty())
+            openers.pop_back();      // Closer k comes before any mismatch of the chunk, so this one matches
+        else if(k-- == 0){
+            offset = summary.base + (long long)i;
+            return false;
+        }
+        return true;
+    });
+    return offset;
+}
+
+// Appends the summary of the chunk that follows left. Only right is ever scanned again, so its bytes
+// must still be in memory; left may cover data that is gone.
+// Time complexity = O(closers of right + openers of right), plus one rescan of right if its offsets are needed
+void combineBrackets(BracketSummary& left, BracketSummary& right){
+    if(left.error != -1)
+        return;                      // The left mismatch comes first
+    std::size_t matched = 0;
+    for(; matched < right.closers.size() && !left.openers.empty(); matched++){
+        if(left.openers.back() != matchingOpener(right.closers[matched])){
+            left.error = closerOffset(right, matched);
+            return;
+        }
+        left.openers.pop_back();
+    }
+    if(left.closers.empty() && matched < right.closers.size())
+        left.first_closer = matched == 0 ? right.first_closer : closerOffset(right, matched);
+    left.closers.insert(left.closers.end(), right.closers.begin() + matched, right.closers.end());
+    left.openers.insert(left.openers.end(), right.openers.begin(), right.openers.end());
+    left.error = right.error;
+    left.length += right.length;     // Adjacent chunks of one buffer stay one contiguous range
+}
+
+// Offset of the first mismatch of a whole input given its summary
+long long bracketResult(const BracketSummary& summary, long long length){
+    if(!summary.closers.empty())     // Closed while nothing was open; it precedes any error
+        return summary.first_closer;
+    if(summary.error != -1)
+        return summary.error;
+    return summary.openers.empty() ? -1 : length;
+}
+
+// Summarizes the chunks of data concurrently and reduces them into one summary
+BracketSummary summarizeParallel(const char* data, std::size_t length, long long base, unsigned threads){
+    std::size_t chunks = std::max(1u, threads);
+    chunks = std::min(chunks, std::max<std::size_t>(1, length / 4096));  // Tiny inputs stay on one thread
+    std::vector<BracketSummary> summaries(chunks);
+    std::vector<std::thread> workers;
+    for(std::size_t c = 0; c < chunks; c++){
+        std::size_t begin = length * c / chunks, end = length * (c + 1) / chunks;
+        workers.emplace_back([&, c, begin, end](){
+            summaries[c] = summarizeBrackets(data + begin, end - begin, base + (long long)begin);
+        });
+    }
+    for(std::thread& worker : workers)
+        worker.join();
+
+    for(std::size_t step = 1; step < chunks; step *= 2){  // Pairwise reduction, one level at a time
+        workers.clear();
+        for(std::size_t c = 0; c + step < chunks; c += 2 * step)
+            workers.emplace_back([&, c, step](){
+                combineBrackets(summaries[c], summaries[c + step]);
+            });
+        for(std::thread& worker : workers)
+            worker.join();
+    }
+    return std::move(summaries[0]);
+}
+
+// Time complexity = O(length / threads + chunk summaries)
+long long firstBracketMismatchParallel(const char* data, std::size_t length, unsigned threads){
+    return bracketResult(summarizeParallel(data, length, 0, threads), (long long)length);
+}
+
+// Function used to validate a whole stream in parallel without loading it in memory
+long long firstBracketMismatchParallel(std::FILE* input, unsigned threads){
+    std::vector<char> buffer(PARALLEL_SEGMENT_SIZE);
+    BracketSummary summary;
+    long long offset = 0;
+    std::size_t length;
+    while((length = std::fread(buffer.data(), 1, buffer.size(), input)) > 0){
+        BracketSummary segment = summarizeParallel(buffer.data(), length, offset, threads);
+        combineBrackets(summary, segment);
+        offset += length;
+        if(summary.error != -1 || !summary.closers.empty())
+            break;                   // The answer is known: stop reading
     }
-    return stack.empty();
+    if(std::ferror(input))
+        throw std::runtime_error("Error while reading the input");
+    return bracketResult(summary, offset);
+}
+
+// Function used to verify if a sequence of parentheses/brackets is well-formed
+bool isWellFormed(const std::string& sequence){
+    BracketValidator validator;
+    validator.feed(sequence.data(), sequence.size());
+    return validator.finish() == -1;
 }
 
-int main(){
+int main(int argc, char* argv[]){
+    if(argc > 1 && std::string(argv[1]) == "--bench"){
+        benchmarkStacks();
+        return 0;
+    }
+    if(argc > 2 && std::string(argv[1]) == "--validate"){
+        unsigned threads = 1;
+        if(argc > 3){
+            const char* text = argv[3];
+            char* end;
+            errno = 0;
+            unsigned long value = std::strtoul(text, &end, 10);
+            // strtoul accepts a sign, so only plain digits are let through
+            if(argc > 4 || *text < '0' || *text > '9' || *end != '\0' || errno == ERANGE ||
+               value < 1 || value > UINT_MAX){
+                std::cout << "Usage: " << argv[0] << " --validate <file|-> [threads >= 1]" << std::endl;
+                return 1;
+            }
+            threads = (unsigned)value;
+        }
+        std::string path = argv[2];
+        std::FILE* input = path == "-" ? stdin : std::fopen(path.c_str(), "rb");
+        if(input == nullptr){
+            std::cout << "Can't open " << path << std::endl;
+            return 1;
+        }
+        long long mismatch = threads > 1 ? firstBracketMismatchParallel(input, threads)
+                                         : firstBracketMismatch(input);
+        if(input != stdin)
+            std::fclose(input);
+        if(mismatch == -1)
+            std::cout << "The input is well-formed." << std::endl;
+        else
+            std::cout << "The input isn't well-formed: first mismatch at byte " << mismatch << std::endl;
+        return mismatch == -1 ? 0 : 2;
+    }
+
     // Testing int stack
     Stack<int> intStack;
 